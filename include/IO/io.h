@@ -4,11 +4,54 @@
 
 #ifndef ODO_IO_H
 #define ODO_IO_H
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Odo::io {
     std::string read_file(const std::string& path);
+
+    // The contents of a file mapped into memory, read only. Pages are loaded when they're first touched,
+    // and the mapping is released when this is destroyed.
+    // Like any mapping, it would show changes made to the file while it's open, and reading past the end
+    // of a file that was truncated in the meantime would crash the program. The functions here that
+    // truncate or overwrite a file call release first, so the interpreter's own writes are safe.
+    // Another program truncating the file still crashes this one.
+    class MappedFile {
+    public:
+        // Throws IOException if the file can't be opened or mapped.
+        static std::shared_ptr<MappedFile> create(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] std::string_view view() const { return {data, size}; }
+
+        // Copies the contents of every mapping of the file into memory of their own, which
+        // takes the place of the mapping at the same address. Their views stay valid,
+        // and they no longer change with the file.
+        static void release(const std::string& path);
+    private:
+        explicit MappedFile(const std::string& path);
+
+        // Whether the pages are still the ones of the file.
+        bool mapped{true};
+        void copy_into_memory();
+
+        const char* data{nullptr};
+        size_t size{0};
+#if defined(_WIN32)
+        // There's no mmap here, so the file is read into memory instead.
+        std::string contents;
+#endif
+    };
+
+    // Files at least this big are mapped by read_file in the interpreter instead of being read.
+    // Smaller ones are cheaper to copy than to map.
+    constexpr size_t map_threshold = 1 << 16;
+    // The size of a regular file, or 0 if it's not one.
+    size_t file_size(const std::string& path);
     std::string get_file_name(const std::string& path, bool ignore_extension = false);
 
     std::string to_absolute_path(const std::string&);
@@ -20,5 +63,88 @@ namespace Odo::io {
     void create_file(const std::string&);
     void write_to_file(const std::string &, const std::string &content);
     void append_to_file(const std::string &, const std::string &content);
+
+    // Stops syncing the standard streams with C stdio, so std::cout keeps its own buffer
+    // and only writes it out when it fills up. Must be called before anything is printed.
+    // Reading stdin still flushes it first, which io::Input does before refilling its buffer.
+    void buffer_stdout();
+    // Ends a line of output. It's flushed right away when stdout is a terminal,
+    // or when buffer_stdout was never called.
+    void end_line();
+
+    // Standard input, read through a buffer of its own instead of std::cin.
+    // Everything that reads stdin has to go through it, or the two buffers would split the input between them.
+    // std::cout is flushed before the buffer is refilled, the same as when std::cin is tied to it.
+    class Input {
+    public:
+        // Reads up to the next newline, which is left out of line.
+        // Returns false when there was nothing left to read.
+        bool read_line(std::string& line);
+        // Skip whitespace and read a number, leaving what comes after it.
+        // Return false, without changing value, if there's no number there.
+        bool read_int(int& value);
+        bool read_double(double& value);
+        // The next character, or -1 at the end of the input.
+        int get();
+        // Drops the next character.
+        void ignore();
+    private:
+        std::vector<char> buffer = std::vector<char>(1 << 16);
+        size_t start{0};
+        size_t end{0};
+
+        // Keeps what's left at the front of the buffer, and reads more after it.
+        bool fill();
+        bool skip_whitespace();
+        // The characters up to the next whitespace, without consuming them.
+        // It's cut short when it doesn't fit in the buffer.
+        std::string_view next_word();
+    };
+
+    Input& standard_input();
+
+    // A file that keeps its own buffer, so writing or reading a little at a time
+    // doesn't reach the system on every call.
+    // Writes go to the file when the buffer fills up, on flush, and when it's closed or destroyed.
+    // Anything as large as the buffer is written directly.
+    class File {
+    public:
+        enum class Mode {
+            Read,
+            Write,
+            Append
+        };
+
+        // Throws IOException if the file can't be opened.
+        File(const std::string& path, Mode mode, size_t buffer_size = 1 << 16);
+        ~File();
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+
+        void write(std::string_view text);
+        // Reads up to the next newline, which is left out of line.
+        // Returns false when there was nothing left to read.
+        bool read_line(std::string& line);
+        bool at_end();
+
+        void flush();
+        void close();
+
+        [[nodiscard]] bool is_open() const { return fd >= 0; }
+        [[nodiscard]] Mode mode() const { return file_mode; }
+        [[nodiscard]] const std::string& path() const { return file_path; }
+    private:
+        int fd{-1};
+        Mode file_mode;
+        std::string file_path;
+        std::vector<char> buffer;
+        // When reading, the unread bytes are the ones in [start, end).
+        // When writing, the first end bytes are waiting to be written.
+        size_t start{0};
+        size_t end{0};
+
+        bool fill();
+        void write_all(const char* data, size_t size);
+    };
 }
 #endif //ODO_IO_H
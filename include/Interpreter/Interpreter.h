@@ -5,11 +5,14 @@
 #ifndef ODO_PORT_INTERPRETER_H
 #define ODO_PORT_INTERPRETER_H
 #include "Parser/parser.h"
+#include "Parser/ModuleLoader.h"
 #include "Parser/AST/Node.h"
 #include "Parser/AST/Forward.h"
 #include "value.h"
 #include "symbol.h"
 #include "frame.h"
+#include "TaskPool.h"
+#include "heap.h"
 #include "SemAnalyzer/SemanticAnalyzer.h"
 #include "Modules/NativeModule.h"
 
@@ -22,14 +25,46 @@
 namespace Odo::Interpreting {
     typedef std::shared_ptr<Value> value_t;
     typedef std::function<value_t(std::vector<value_t>)> NativeFunction;
+
+    class Interpreter;
+
+    // A function that can be called many times in a row, like the comparison a native sort calls.
+    // Its parameters are declared once, and every call only gives them new values.
+    class RepeatedCall {
+        Interpreter& inter;
+        std::shared_ptr<FunctionValue> function;
+        SymbolTable scope;
+        // The symbol of each parameter, and whether the arguments it gets are copied.
+        std::vector<std::pair<Symbol*, bool>> params;
+    public:
+        RepeatedCall(Interpreter& inter_, std::shared_ptr<FunctionValue> function_);
+        RepeatedCall(const RepeatedCall&) = delete;
+
+        value_t operator()(std::vector<value_t> arguments);
+    };
+
+    /*
+     * Thread safety:
+     *  Every Interpreter owns its scopes, values, heap, call stack, analyzer and control flow state,
+     *  so independent interpreters can run at the same time on different threads.
+     *  A single interpreter must only be used from one thread at a time.
+     *  The primitive types live in a table that is shared by all of them and is read only.
+     *  Natives that write to the console or read from stdin share the process' streams.
+     */
     class Interpreter {
         Parsing::Parser parser;
+        Parsing::ModuleLoader modules;
 
         std::shared_ptr<Semantics::SemanticAnalyzer> analyzer {nullptr};
 
-        std::vector<value_t> constructorParams;
+        // The parameters of the constructors that are running, a frame for each.
+        // They're kept between calls, so making an instance doesn't allocate them.
+        std::vector<std::vector<Symbol>> constructor_frames;
+        size_t constructors_running{0};
 
-        SymbolTable globalTable;
+        // Shared with the workers, like the global table.
+        std::shared_ptr<Heap> heap;
+        std::shared_ptr<SymbolTable> globalTable;
         SymbolTable* currentScope;
         SymbolTable replScope;
 
@@ -50,10 +85,29 @@ namespace Odo::Interpreting {
         unsigned int current_col{0};
 
         std::map<std::string, NativeFunction> native_functions;
+        void register_native_functions();
+
+        // Set on the interpreters that run the iterations of a parallel forange.
+        // They share the global table of the interpreter that created them,
+        // but have their own scopes, call stack and control flow flags.
+        bool is_worker = false;
+        Interpreter(Interpreter& parent, SymbolTable* scope);
+        void run_parallel_range(const std::shared_ptr<Parsing::FoRangeNode>& node, int min_in_range, int max_in_range);
+
+        // Called between statements. Collects cycles of values when it's due,
+        // unless another thread could be using them.
+        void collect_cycles();
 
         std::pair<value_t, value_t>
         coerce_type(const value_t& lhs, const value_t& rhs);
 
+        // Handles `s = s + x` and `s += x` on strings by appending to the value of the variable,
+        // as long as nothing else holds it. Returns false if the assignment isn't one of those.
+        bool append_in_place(const std::shared_ptr<Parsing::AssignmentNode>& node, Symbol* varSym);
+
+        // Calls a comparison function from the sort natives, which has to return a bool.
+        bool comes_before(RepeatedCall& cmp, const value_t& a, const value_t& b);
+
         Symbol* int_type;
         Symbol* double_type;
         Symbol* string_type;
@@ -64,6 +118,8 @@ namespace Odo::Interpreting {
         value_t create_literal(int val);
         value_t create_literal(double val);
         value_t create_literal(bool val);
+        // The string with just this character. It's shared, like every value that's stored without being copied.
+        static value_t create_char_literal(char val);
 
         INTER_VISITOR(Double);
         INTER_VISITOR(Int);
@@ -99,6 +155,7 @@ namespace Odo::Interpreting {
         INTER_VISITOR(Index);
 
         INTER_VISITOR(ListExpression);
+        INTER_VISITOR(MapExpression);
 
         INTER_VISITOR(Module);
         INTER_VISITOR(Import);
@@ -118,8 +175,6 @@ namespace Odo::Interpreting {
 
         INTER_VISITOR(ConstructorDecl);
 
-        INTER_VISITOR(ConstructorCall);
-
         INTER_VISITOR(ClassInitializer);
 
         INTER_VISITOR(InstanceBody);
@@ -132,10 +187,21 @@ namespace Odo::Interpreting {
         Interpreting::Symbol* handle_list_type(Interpreting::Symbol* sym, int dimensions);
 
         std::vector<std::pair<Symbol*, bool>> getParamTypes(const std::vector<std::shared_ptr<Parsing::Node>>&);
+        Symbol* function_type_of(const std::shared_ptr<Parsing::FuncDeclNode>& node);
+        Symbol* list_type_of(const std::shared_ptr<Parsing::ListDeclarationNode>& node);
+
+        ClassLayout::Constructor constructor_layout(const std::shared_ptr<Parsing::ConstructorDeclNode>& node, size_t level);
+        std::shared_ptr<const ClassLayout> layout_of(const std::shared_ptr<ClassValue>& cls);
+        // Runs a constructor for a new instance, with the arguments it was given already in frame.
+        void construct(const ClassLayout::Constructor& constructor, Symbol* frame, size_t n_args, SymbolTable* levelScope);
+        // Runs the statements of one level of the class for a new instance, declaring its members in their slots.
+        void init_members(const std::shared_ptr<InstanceValue>& instance, const ClassLayout::Level& level, SymbolTable* scope);
 
         Symbol *getSymbolFromNode(const std::shared_ptr<Parsing::Node>& mem);
+        Symbol *getIndexSymbol(const value_t& source, const std::shared_ptr<Parsing::IndexNode>& node);
 
         friend class Semantics::SemanticAnalyzer;
+        friend class RepeatedCall;
     public:
         void interpret(std::string);
         value_t eval(std::string);
@@ -144,7 +210,8 @@ namespace Odo::Interpreting {
         int add_native_function(const std::string& name, NativeFunction callback);
         void add_function(const std::string &name, const std::function<void()> &callback);
 
-        SymbolTable& get_global() { return globalTable; };
+        SymbolTable& get_global() { return *globalTable; };
+        static SymbolTable& primitive_types();
 
         std::shared_ptr<Semantics::SemanticAnalyzer> get_analyzer() { return analyzer; }
 
@@ -153,6 +220,17 @@ namespace Odo::Interpreting {
 
         std::vector<Frame>& get_call_stack() { return call_stack; };
         value_t get_null() { return null; }
+
+        value_t call_function(const std::shared_ptr<FunctionValue>&, std::vector<value_t>);
+
+        // Interpreters made by create_worker can run functions of this one on another thread.
+        // They share its global table, so the functions they run must pass the same checks as
+        // the body of a parallel forange, and may not read variables declared outside of them.
+        std::unique_ptr<Interpreter> create_worker();
+        TaskPool& get_task_pool();
+    private:
+        // Declared last, so the pool finishes its jobs before anything they use is destroyed.
+        std::unique_ptr<TaskPool> task_pool{nullptr};
     };
 }
 #endif //ODO_PORT_INTERPRETER_H
@@ -0,0 +1,67 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_TASKPOOL_H
+#define ODO_TASKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Odo::Interpreting {
+    // A work-stealing scheduler for the jobs of the task module.
+    // Every thread has its own queue. Jobs submitted from a thread of the pool go to the back of its queue,
+    // and the rest are spread across all of them. A thread takes work from the back of its own queue,
+    // and steals from the front of the others when it runs out.
+    // The threads are started with the first job, and the pool finishes every queued job before it's destroyed.
+    class TaskPool {
+    public:
+        typedef std::function<void()> job;
+
+        explicit TaskPool(unsigned int n_threads = 0);
+        ~TaskPool();
+
+        void submit(job);
+
+        // Runs one queued job on the calling thread, so a thread that waits for a result can help.
+        // Returns false if there was nothing to run.
+        bool run_pending();
+
+        // Returns once every job submitted so far, and every job those submitted, has finished.
+        void wait_all();
+
+        [[nodiscard]] unsigned int size() const { return n_threads; }
+    private:
+        struct queue {
+            std::mutex mutex;
+            std::deque<job> jobs;
+        };
+
+        unsigned int n_threads;
+        std::vector<std::unique_ptr<queue>> queues;
+        std::vector<std::thread> threads;
+        std::once_flag started;
+
+        std::atomic<size_t> queued{0};
+        // Queued or running.
+        std::atomic<size_t> unfinished{0};
+        std::atomic<size_t> next_queue{0};
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        bool take(size_t index, job& out);
+        bool steal(size_t thief, job& out);
+        void run(job& j);
+        void work(size_t index);
+    };
+}
+
+#endif //ODO_TASKPOOL_H
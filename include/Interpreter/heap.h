@@ -0,0 +1,135 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_HEAP_H
+#define ODO_HEAP_H
+
+#include "value.h"
+#include "frame.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace Odo::Interpreting {
+    // Frees the values that only point to each other, which counting references never does.
+    // Lists, maps, instances, classes and methods are the only values that hold others, so they're the only ones tracked.
+    //
+    // A collection counts how many references each tracked value gets from the others, and the ones with
+    // more owners than that are held from outside (a scope, a frame, the interpreter). Whatever those don't
+    // reach is a cycle of garbage, and gets emptied so the references inside of it go away.
+    //
+    // New values are collected on their own, so a collection only looks at the ones made since the last one.
+    // The ones that survive are only looked at again when there's twice as many of them as after the last full collection.
+    //
+    // Every interpreter that runs a program has a heap of its own, and shares it with its workers.
+    // Values are tracked by the heap of the interpreter running on the thread they're made in.
+    class Heap {
+    public:
+        struct Stats {
+            // The tracked values that are still alive.
+            std::map<ValueType, size_t> live;
+            size_t collections{0};
+            size_t full_collections{0};
+            size_t reclaimed_objects{0};
+            size_t reclaimed_bytes{0};
+        };
+
+        // Values made on this thread while it's around are tracked by heap.
+        // The heap before it is used again once it's gone.
+        class Use {
+            Heap& heap;
+            Heap* previous;
+        public:
+            explicit Use(Heap& heap);
+            ~Use();
+
+            Use(const Use&) = delete;
+            Use& operator=(const Use&) = delete;
+        };
+
+        // The heap values made on this thread go to, if an interpreter is running on it.
+        static Heap* current();
+
+        void track(const std::shared_ptr<Value>& value);
+
+        // Collects if enough values were made since the last collection. Called between statements.
+        void maybe_collect() {
+            if (young_size.load(std::memory_order_relaxed) >= young_limit && users.load() <= 1) collect(false);
+        }
+
+        // Returns how many values were freed. A full collection looks at every tracked value.
+        // Nothing is collected while another thread is running the program, since it could be using the values.
+        size_t collect(bool full);
+
+        // Calls fn, unless another thread is running the program, and returns whether it did.
+        // No other thread starts running it until fn returns.
+        template<typename Fn>
+        bool run_alone(Fn&& fn) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (users > 1) return false;
+
+            fn();
+            return true;
+        }
+
+        Stats stats();
+    private:
+        static constexpr size_t young_limit = 5000;
+
+        std::mutex mutex;
+        // The threads with a Use of this heap. A thread that's already using it doesn't count twice.
+        // Only changed while holding the mutex.
+        std::atomic<size_t> users{0};
+        std::vector<std::weak_ptr<Value>> young;
+        std::vector<std::weak_ptr<Value>> old;
+        std::atomic<size_t> young_size{0};
+
+        // Dead values stay in the lists until they're pruned, and the memory of the
+        // value isn't given back while a weak pointer to it is left.
+        size_t prune_at{young_limit * 2};
+        size_t old_limit{young_limit * 4};
+
+        Stats totals;
+    };
+
+    // Keeps every value along with where in the program it was made, for --heap-profile.
+    // A value is attributed to the line and column being run when it's made, and to the function running it.
+    class HeapProfile {
+    public:
+        // Only values made after this are seen, so it's called before the program starts.
+        static void enable() { on = true; }
+        static bool enabled() { return on; }
+
+        // Values made on this thread while it's around are attributed to the position of an interpreter.
+        // The one before it is used again once it's gone.
+        class Attribution {
+            friend class HeapProfile;
+
+            const unsigned int& line;
+            const unsigned int& col;
+            const std::vector<Frame>& call_stack;
+            const Attribution* previous{nullptr};
+        public:
+            Attribution(const unsigned int& line_, const unsigned int& col_, const std::vector<Frame>& call_stack_);
+            ~Attribution();
+
+            Attribution(const Attribution&) = delete;
+            Attribution& operator=(const Attribution&) = delete;
+        };
+
+        static void record(const std::shared_ptr<Value>& value);
+        static void forget(const Value* value);
+
+        // Writes the bytes and counts of the values that are alive, by type and by where they were made.
+        static void report(std::ostream& out);
+    private:
+        static inline bool on = false;
+    };
+}
+
+#endif //ODO_HEAP_H
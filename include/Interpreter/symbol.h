@@ -11,6 +11,7 @@
 #include "utils.h"
 #include <memory>
 #include <functional>
+#include <shared_mutex>
 
 #include "Translations/lang.h"
 
@@ -21,6 +22,7 @@ namespace Odo::Interpreting {
     enum class SymbolType {
         VarSymbol,
         ListType,
+        MapType,
         PrimitiveType,
         ClassType,
         FunctionType,
@@ -54,6 +56,9 @@ namespace Odo::Interpreting {
 
         std::function<void(Symbol*)> ondestruction{nullptr};
 
+        // The type of the keys, for map types. tp is the type of the values.
+        Symbol* key_tp{nullptr};
+
         [[nodiscard]] bool is_numeric() const { return name == INT_TP || name == DOUBLE_TP; }
 
         static std::string constructFuncTypeName(Symbol* type, const std::vector< std::pair<Symbol*, bool> >& paramTypes) {
@@ -89,6 +94,14 @@ namespace Odo::Interpreting {
 
         std::unordered_map<std::string, Symbol*> aliases{};
 
+        // Symbols kept outside of the table, in a block shared with others that have the same names,
+        // like the members of an instance. The names are laid out once, and only the block changes.
+        const std::unordered_map<std::string, size_t>* slot_names{nullptr};
+        Symbol* slots{nullptr};
+
+        // Only set on tables that other threads read while their owner keeps changing them.
+        std::shared_ptr<std::shared_mutex> guard{nullptr};
+
     public:
         SymbolTable();
         SymbolTable(std::string, std::unordered_map<std::string, Symbol> types, SymbolTable *parent= nullptr);
@@ -101,6 +114,7 @@ namespace Odo::Interpreting {
         Symbol* addAlias(const std::string&, const std::string&);
         void removeSymbol(Symbol*);
         Symbol* addListType(Symbol*);
+        Symbol* addMapType(Symbol* key, Symbol* value);
         bool symbolExists(const std::string&);
 
         std::string getName() { return scopeName; }
@@ -108,6 +122,16 @@ namespace Odo::Interpreting {
         SymbolTable* getParent() { return parent; }
         void setParent(SymbolTable* newP) { parent = newP; }
 
+        // Makes the names in slot_names_ find the symbols at their position in slots_.
+        void setSlots(const std::unordered_map<std::string, size_t>* slot_names_, Symbol* slots_) {
+            slot_names = slot_names_;
+            slots = slots_;
+        }
+
+        // From now on, lookups and changes to this table take a lock.
+        // Must be called before the other threads start reading it.
+        void share_between_threads();
+
         Symbol *addFuncType(Symbol *pSymbol, const std::vector<std::pair<Symbol*, bool>>& vector);
         Symbol *addFuncType(Symbol *pSymbol, const std::string& funcName);
 
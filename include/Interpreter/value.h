@@ -7,21 +7,28 @@
 
 #include <any>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <sstream>
 
 #include <string>
+#include <string_view>
 #include <variant>
 #include <Parser/AST/Node.h>
 #include <functional>
 #include "Translations/lang.h"
 
 #include "symbol.h"
+#include "IO/io.h"
 namespace Odo::Interpreting {
 
     enum class ValueType {
         NormalVal,
         ListVal,
+        MapVal,
+        MatrixVal,
+        FileVal,
         FunctionVal,
         ModuleVal,
         ClassVal,
@@ -31,9 +38,26 @@ namespace Odo::Interpreting {
         NativeFunctionVal
     };
 
+    // Where values render their text: the end of a string, or a stream like std::cout,
+    // so printing a big list goes straight into the output buffer.
+    class Sink {
+        std::string* text{nullptr};
+        std::ostream* stream{nullptr};
+    public:
+        explicit Sink(std::string& text_): text(&text_) {}
+        explicit Sink(std::ostream& stream_): stream(&stream_) {}
+
+        void write(std::string_view part) {
+            if (text) {
+                text->append(part);
+            } else {
+                stream->write(part.data(), static_cast<std::streamsize>(part.size()));
+            }
+        }
+    };
+
     struct Value {
         Symbol* type {nullptr};
-        bool important{false};
 
         virtual ValueType kind()=0;
         virtual std::shared_ptr<Value> copy()=0;
@@ -47,6 +71,8 @@ namespace Odo::Interpreting {
         }
 
         virtual std::string to_string() { return VALUE_AT_MSG + address_as_str(); }
+        // Writes the same text as to_string into out, without building it as a whole first.
+        virtual void render(Sink& out) { out.write(to_string()); }
 
         template<typename T>
         static std::shared_ptr<T> as(const std::shared_ptr<Value>& v) {
@@ -54,8 +80,12 @@ namespace Odo::Interpreting {
         }
 
         explicit Value(Symbol* sym): type(sym) { }
+        virtual ~Value();
     };
 
+    // A string value holds either a std::string, or a mapped_text that shares the memory of a file.
+    typedef std::shared_ptr<const io::MappedFile> mapped_text;
+
     struct NormalValue final: public Value {
         std::any val;
 
@@ -69,8 +99,16 @@ namespace Odo::Interpreting {
         double as_double();
         bool as_bool();
         std::string as_string();
+        // Reads the string without copying it. The view is valid while the value is held,
+        // since a string is only changed in place when nothing else holds its value.
+        std::string_view as_string_view();
+        // The string, to be changed in place. A string backed by a mapped file is copied out of it first.
+        std::string& own_string();
+        // val, as natives that take primitives expect it, with mapped strings turned into std::string.
+        std::any primitive();
 
         std::string to_string() final;
+        void render(Sink& out) final;
         NormalValue(Symbol *tp, std::any the_value);
 
         static std::shared_ptr<NormalValue> create(Symbol *tp, std::any the_value);
@@ -84,17 +122,99 @@ namespace Odo::Interpreting {
         std::shared_ptr<Value> copy() final;
 
         std::string to_string() final;
+        void render(Sink& out) final;
         std::vector<std::shared_ptr<Value>> as_list_value();
         ListValue(Symbol* tp, std::vector<Symbol> sym_elements);
 
         static std::shared_ptr<ListValue> create(Symbol* tp, std::vector<Symbol> sym_elements);
     };
 
+    // A hash table with open addressing and linear probing.
+    // The entries are kept in the order they were added, and the slots only hold their positions,
+    // so iterating and copying don't touch the table at all.
+    // Keys are ints, doubles, strings or bools, and are never changed once they're in the map.
+    struct MapValue final: public Value {
+        struct entry {
+            size_t hash;
+            std::shared_ptr<Value> key;
+            Symbol value;
+        };
+
+        std::vector<entry> entries;
+        ValueType kind() final { return ValueType::MapVal; }
+        [[nodiscard]] bool is_copyable() const final { return true; }
+
+        std::shared_ptr<Value> copy() final;
+
+        std::string to_string() final;
+        void render(Sink& out) final;
+
+        // The symbol holding the value of key, or nullptr if it's not in the map.
+        Symbol* find(const std::shared_ptr<Value>& key);
+        // Replaces the value of key, or adds it after the rest of the entries.
+        void set(std::shared_ptr<Value> key, std::shared_ptr<Value> value);
+        void clear();
+
+        explicit MapValue(Symbol* tp);
+
+        static std::shared_ptr<MapValue> create(Symbol* tp);
+    private:
+        // Positions in entries plus one, so zero is an empty slot. The size is always a power of two.
+        std::vector<uint32_t> slots;
+
+        size_t find_slot(size_t hash, Value& key);
+        void grow();
+    };
+
+    // A dense matrix of doubles, stored by rows in one buffer.
+    // Made by the matrix module, and copied like lists are.
+    struct MatrixValue final: public Value {
+        size_t rows;
+        size_t cols;
+        std::vector<double> data;
+        ValueType kind() final { return ValueType::MatrixVal; }
+        [[nodiscard]] bool is_copyable() const final { return true; }
+
+        double& at(size_t row, size_t col) { return data[row * cols + col]; }
+
+        std::shared_ptr<Value> copy() final;
+
+        std::string to_string() final;
+        // Written like the double[][] with the same elements.
+        void render(Sink& out) final;
+
+        MatrixValue(Symbol* tp, size_t rows_, size_t cols_, std::vector<double> data_);
+
+        static std::shared_ptr<MatrixValue> create(Symbol* tp, size_t rows_, size_t cols_, std::vector<double> data_);
+        static std::shared_ptr<MatrixValue> create(Symbol* tp, size_t rows_, size_t cols_);
+    };
+
+    // A file opened by the io module. It's shared instead of copied,
+    // and the file is closed when the last reference to it goes away.
+    struct FileValue final: public Value {
+        std::shared_ptr<io::File> file;
+        ValueType kind() final { return ValueType::FileVal; }
+
+        std::shared_ptr<Value> copy() final;
+
+        std::string to_string() final { return FILE_AT_MSG + file->path() + "'>"; }
+
+        FileValue(Symbol* tp, std::shared_ptr<io::File> file_);
+
+        static std::shared_ptr<FileValue> create(Symbol* tp, std::shared_ptr<io::File> file_);
+    };
+
     struct FunctionValue final: public Value {
         std::vector<std::shared_ptr<Parsing::Node>> params;
         std::shared_ptr<Parsing::Node> body;
         SymbolTable* parentScope{};
         std::string name;
+
+        // Methods are declared in the scopes of their instance, and keep it alive so they can be called
+        // after everything else has let go of it. The instance holds its methods too, so the two
+        // are tracked by the heap, which frees them once nothing else points to either.
+        std::shared_ptr<Value> instance;
+
         ValueType kind() final { return ValueType::FunctionVal; }
 
         std::shared_ptr<Value> copy() final;
@@ -103,7 +223,7 @@ namespace Odo::Interpreting {
 
         FunctionValue(Symbol* tp, std::vector<std::shared_ptr<Parsing::Node>> params_, std::shared_ptr<Parsing::Node> body_, SymbolTable* scope_, std::string name="<anonymous>");
 
-        static std::shared_ptr<FunctionValue> create(Symbol* tp, std::vector<std::shared_ptr<Parsing::Node>> params_, std::shared_ptr<Parsing::Node> body_, SymbolTable* scope_, std::string name="<anonymous>");
+        static std::shared_ptr<FunctionValue> create(Symbol* tp, std::vector<std::shared_ptr<Parsing::Node>> params_, std::shared_ptr<Parsing::Node> body_, SymbolTable* scope_, std::string name=ANONYMUS_MSG);
     };
 
     struct ModuleValue : public Value {
@@ -121,11 +241,55 @@ namespace Odo::Interpreting {
         static std::shared_ptr<ModuleValue> create(Symbol* tp, const SymbolTable& scope);
     };
 
+    // Where the members of the instances of a class go. It's worked out the first time the class is
+    // instantiated, and includes the members of the classes it inherits from, so every instance keeps
+    // all of its members in one block, and finding one is a single lookup by name.
+    struct ClassLayout {
+        static constexpr size_t no_slot = -1;
+        // Every instance has itself in the first slot.
+        static constexpr size_t this_slot = 0;
+
+        // A statement in the body of a class. The ones that declare a member have its slot and its type.
+        struct Member {
+            std::shared_ptr<Parsing::Node> statement;
+            size_t slot{no_slot};
+            Symbol* tp{nullptr};
+        };
+
+        // The members of one of the classes in the chain. Its methods only see
+        // the ones declared in it and in the classes it inherits from.
+        struct Level {
+            std::vector<Member> members;
+            std::unordered_map<std::string, size_t> names;
+        };
+
+        // The constructor of the last class in the chain that declares one.
+        // Its parameters are bound in a frame of symbols, in the order they're declared.
+        struct Constructor {
+            std::shared_ptr<Parsing::Node> declaration;
+            size_t level{0};
+            std::unordered_map<std::string, size_t> names;
+            std::vector<std::string> param_names;
+            std::vector<Symbol*> param_types;
+        };
+
+        // Starting from the class at the top of the chain.
+        std::vector<Level> levels;
+        std::optional<Constructor> constructor;
+        // The slot of each name in an instance. Members of subclasses take the place of the ones they hide.
+        std::unordered_map<std::string, size_t> names;
+        std::vector<std::string> slot_names;
+    };
+
     struct ClassValue final: public Value {
         SymbolTable ownScope;
         std::shared_ptr<Parsing::Node> body;
         // What's the point of the parent scope if ownscope has it?
         SymbolTable* parentScope;
+
+        std::shared_ptr<const ClassLayout> layout{nullptr};
+        std::once_flag layout_built;
+
         ValueType kind() final { return ValueType::ClassVal; }
 
         std::shared_ptr<Value> copy() final;
@@ -139,19 +303,32 @@ namespace Odo::Interpreting {
         Symbol* getStaticVarSymbol(const std::string& name);
     };
 
-    struct InstanceValue final: public Value {
+    // An instance owns everything its members live in. Its methods point back to it,
+    // so one that has any is freed by the heap once nothing else points to it.
+    struct InstanceValue final: public Value, public std::enable_shared_from_this<InstanceValue> {
         std::shared_ptr<ClassValue> molde;
+        std::shared_ptr<const ClassLayout> layout;
+        // Every member, in the order of the layout. It's never resized, so the symbols don't move.
+        // `this` points to the instance without owning it, or it would keep itself alive.
+        std::vector<Symbol> slots;
+        // A scope for each class in the chain, over the same slots, starting from the top of the chain.
+        // Each one has the one before as its parent. It's never resized either.
+        std::vector<SymbolTable> levels;
+        // Finds the members by name, and whatever else the body of the class declared through its parent.
         SymbolTable ownScope;
 
+        // What reading a symbol gives, with an owning pointer for `this`.
+        static std::shared_ptr<Value> owned(const std::shared_ptr<Value>& value);
+
         ValueType kind() final { return ValueType::InstanceVal; }
 
         std::shared_ptr<Value> copy() final;
 
         std::string to_string() final { return INSTANCE_AT_MSG + address_as_str(); }
 
-        InstanceValue(Symbol* tp, std::shared_ptr<ClassValue> molde_, const SymbolTable& scope);
+        InstanceValue(Symbol* tp, std::shared_ptr<ClassValue> molde_, std::shared_ptr<const ClassLayout> layout_);
 
-        static std::shared_ptr<InstanceValue> create(Symbol* tp, std::shared_ptr<ClassValue> molde_, const SymbolTable& scope);
+        static std::shared_ptr<InstanceValue> create(Symbol* tp, std::shared_ptr<ClassValue> molde_, std::shared_ptr<const ClassLayout> layout_);
 
         Symbol* getStaticVarSymbol(const std::string& name);
     };
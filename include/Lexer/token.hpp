@@ -80,6 +80,7 @@ namespace Odo::Lexing {
         FOR,
         FOREACH,
         FORANGE,
+        PARALLEL,
         WHILE,
         LOOP,
         BREAK,
@@ -8,13 +8,44 @@
 #include "Interpreter/Interpreter.h"
 #include "NativeModule.h"
 #include "IO/io.h"
+#include "Exceptions/exception.h"
 
 namespace Odo::Modules {
     class IOModule final : public NativeModule {
+        Interpreting::Interpreter& inter;
+        Interpreting::Symbol* file_type;
+
+        static std::shared_ptr<io::File> open_file(const std::string& path, const std::string& mode);
+
+        // The file of a handle, checked to be open, and readable or writable if asked.
+        static io::File& file_of(const Interpreting::value_t& value, bool reading = false, bool writing = false);
+
+        [[noreturn]] static void failed(const io::File& file, bool reading);
+
+        // Turns a failure of the system into an error of the program,
+        // reported as a failed read or a failed write.
+        template<typename Fn>
+        static auto on_file(io::File& file, bool reading, Fn fn) {
+            try {
+                return fn();
+            } catch (Exceptions::IOException&) {
+                failed(file, reading);
+            }
+        }
     public:
-        explicit IOModule(Interpreting::Interpreter& inter)
-        : NativeModule(module_name(), inter)
+        explicit IOModule(Interpreting::Interpreter& inter_)
+        : NativeModule(module_name(), inter_)
+        , inter(inter_)
         {
+            file_type = ownScope.addSymbol({
+                .tp = any_type,
+                .name = FILE_TP,
+                .isType = true,
+                .kind = Interpreting::SymbolType::PrimitiveType
+            });
+            // Files are iterated by lines.
+            analyzer.lock()->add_iterable_type(file_type, string_type);
+
             add_function(WRITE_TO_FILE_FN, {{string_type, false}, {string_type, false}}, nullptr,
                 [](auto vals){
                     auto path = std::any_cast<std::string>(vals[0]);
@@ -24,6 +55,76 @@ namespace Odo::Modules {
                     return nullptr;
                 }
             );
+
+            // Handles to open files, for reading or writing a little at a time.
+            // The mode is "r" by default, and the file is closed when the handle is no longer used.
+            add_values_function(OPEN_FN, {{string_type, false}, {string_type, true}}, file_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto path = Interpreting::Value::as<Interpreting::NormalValue>(vals[0])->as_string();
+                    std::string mode = FILE_READ_MODE;
+                    if (vals.size() > 1) {
+                        mode = Interpreting::Value::as<Interpreting::NormalValue>(vals[1])->as_string();
+                    }
+
+                    return Interpreting::FileValue::create(file_type, open_file(path, mode));
+                }
+            );
+
+            // Opens a file to go through its lines with foreach, reading them as the loop goes.
+            add_values_function(LINES_FN, {{string_type, false}}, file_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto path = Interpreting::Value::as<Interpreting::NormalValue>(vals[0])->as_string();
+                    return Interpreting::FileValue::create(file_type, open_file(path, FILE_READ_MODE));
+                }
+            );
+
+            // Takes any value, and writes the same text writeln would.
+            add_values_function(WRITE_FN, {{file_type, false}, {any_type, false}}, nullptr,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto& file = file_of(vals[0], false, true);
+                    auto as_normal = std::dynamic_pointer_cast<Interpreting::NormalValue>(vals[1]);
+                    on_file(file, false, [&] {
+                        if (as_normal && as_normal->type == string_type) {
+                            file.write(as_normal->as_string_view());
+                        } else {
+                            file.write(vals[1]->to_string());
+                        }
+                    });
+                    return inter.get_null();
+                }
+            );
+
+            add_values_function(READ_LINE_FN, {{file_type, false}}, string_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto& file = file_of(vals[0], true);
+                    std::string line;
+                    on_file(file, true, [&] { return file.read_line(line); });
+                    return Interpreting::NormalValue::create(string_type, std::move(line));
+                }
+            );
+
+            add_values_function(AT_END_FN, {{file_type, false}}, bool_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto& file = file_of(vals[0], true);
+                    return Interpreting::NormalValue::create(bool_type, on_file(file, true, [&] { return file.at_end(); }));
+                }
+            );
+
+            add_values_function(FLUSH_FN, {{file_type, false}}, nullptr,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto& file = file_of(vals[0]);
+                    on_file(file, false, [&] { file.flush(); });
+                    return inter.get_null();
+                }
+            );
+
+            add_values_function(CLOSE_FN, {{file_type, false}}, nullptr,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto& file = file_of(vals[0]);
+                    on_file(file, file.mode() == io::File::Mode::Read, [&] { file.close(); });
+                    return inter.get_null();
+                }
+            );
         }
         std::string module_name() final { return IO_MD; }
     };
@@ -82,6 +82,7 @@ namespace Odo::Modules {
             );
         }
         std::string module_name() final { return MATH_MD; }
+        bool is_pure() final { return true; }
     };
 }
 
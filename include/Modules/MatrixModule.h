@@ -0,0 +1,203 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_MATRIXMODULE_H
+#define ODO_MATRIXMODULE_H
+#include "Interpreter/Interpreter.h"
+#include "NativeModule.h"
+#include "VecModule.h"
+#include "Exceptions/exception.h"
+
+#include <cstddef>
+
+namespace Odo::Modules {
+    // The loops behind the matrix module, over matrices stored by rows.
+    namespace matrix_kernels {
+        // out (n x p) = a (n x m) * b (m x p). out has to start as zeros.
+        void matmul(const double* a, const double* b, double* out, size_t n, size_t m, size_t p);
+        // out (cols x rows) = the transpose of a (rows x cols).
+        void transpose(const double* a, double* out, size_t rows, size_t cols);
+        void sub(const double* x, const double* y, double* out, size_t n);
+    }
+
+    // Dense matrices of doubles, kept in one buffer instead of a list of lists.
+    // They're turned into and made from double[][] in a single pass, and every operation makes a new matrix.
+    class MatrixModule final : public NativeModule {
+        Interpreting::Interpreter& inter;
+        Interpreting::Symbol* matrix_type;
+
+        typedef std::shared_ptr<Interpreting::MatrixValue> matrix_t;
+
+        static matrix_t as_matrix(const Interpreting::value_t& value) {
+            return Interpreting::Value::as<Interpreting::MatrixValue>(value);
+        }
+
+        // Numbers can be given as ints or doubles where the other is expected.
+        double read_number(const Interpreting::value_t& value) {
+            auto as_normal = Interpreting::Value::as<Interpreting::NormalValue>(value);
+            return as_normal->type == int_type ? as_normal->as_int() : as_normal->as_double();
+        }
+
+        int read_int(const Interpreting::value_t& value) { return (int)read_number(value); }
+
+        size_t read_size(const Interpreting::value_t& value);
+
+        static void same_shape(const matrix_t& a, const matrix_t& b);
+
+        // Checks that a position is inside of the matrix.
+        static void check_index(const matrix_t& m, int row, int col);
+
+        // The columns of a have to be as many as the rows of b.
+        static void check_matmul(const matrix_t& a, const matrix_t& b);
+
+        static std::string shape_of(const matrix_t& m) {
+            return std::to_string(m->rows) + "x" + std::to_string(m->cols);
+        }
+
+        matrix_t from_list(const Interpreting::value_t& value);
+
+        Interpreting::value_t to_list(const matrix_t& m) {
+            auto row_type = inter.get_global().addListType(double_type);
+            std::vector<Interpreting::Symbol> rows;
+            rows.reserve(m->rows);
+            for (size_t row = 0; row < m->rows; row++) {
+                std::vector<Interpreting::Symbol> elements;
+                elements.reserve(m->cols);
+                for (size_t col = 0; col < m->cols; col++) {
+                    elements.push_back({double_type, "list_element", Interpreting::NormalValue::create(double_type, m->at(row, col))});
+                }
+
+                rows.push_back({row_type, "list_element", Interpreting::ListValue::create(row_type, std::move(elements))});
+            }
+
+            return Interpreting::ListValue::create(inter.get_global().addListType(row_type), std::move(rows));
+        }
+    public:
+        explicit MatrixModule(Interpreting::Interpreter& inter_)
+            : NativeModule(module_name(), inter_)
+            , inter(inter_)
+        {
+            matrix_type = ownScope.addSymbol({
+                .tp = any_type,
+                .name = MATRIX_TP,
+                .isType = true,
+                .kind = Interpreting::SymbolType::PrimitiveType
+            });
+
+            auto table_type = inter.get_global().addListType(inter.get_global().addListType(double_type));
+
+            add_values_function(FROM_LIST_FN, {{table_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    return from_list(vals[0]);
+                }
+            );
+
+            add_values_function(TO_LIST_FN, {{matrix_type, false}}, table_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    return to_list(as_matrix(vals[0]));
+                }
+            );
+
+            add_values_function(ZEROS_FN, {{int_type, false}, {int_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    return Interpreting::MatrixValue::create(matrix_type, read_size(vals[0]), read_size(vals[1]));
+                }
+            );
+
+            add_values_function(IDENTITY_FN, {{int_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto n = read_size(vals[0]);
+                    auto result = Interpreting::MatrixValue::create(matrix_type, n, n);
+                    for (size_t i = 0; i < n; i++) {
+                        result->at(i, i) = 1;
+                    }
+
+                    return result;
+                }
+            );
+
+            add_values_function(ROWS_FN, {{matrix_type, false}}, int_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    return Interpreting::NormalValue::create(int_type, (int)as_matrix(vals[0])->rows);
+                }
+            );
+
+            add_values_function(COLS_FN, {{matrix_type, false}}, int_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    return Interpreting::NormalValue::create(int_type, (int)as_matrix(vals[0])->cols);
+                }
+            );
+
+            add_values_function(GET_FN, {{matrix_type, false}, {int_type, false}, {int_type, false}}, double_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto m = as_matrix(vals[0]);
+                    auto row = read_int(vals[1]);
+                    auto col = read_int(vals[2]);
+                    check_index(m, row, col);
+
+                    return Interpreting::NormalValue::create(double_type, m->at(row, col));
+                }
+            );
+
+            add_values_function(MATMUL_FN, {{matrix_type, false}, {matrix_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto a = as_matrix(vals[0]);
+                    auto b = as_matrix(vals[1]);
+                    check_matmul(a, b);
+
+                    auto result = Interpreting::MatrixValue::create(matrix_type, a->rows, b->cols);
+                    matrix_kernels::matmul(a->data.data(), b->data.data(), result->data.data(), a->rows, a->cols, b->cols);
+                    return result;
+                }
+            );
+
+            add_values_function(TRANSPOSE_FN, {{matrix_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto m = as_matrix(vals[0]);
+                    auto result = Interpreting::MatrixValue::create(matrix_type, m->cols, m->rows);
+                    matrix_kernels::transpose(m->data.data(), result->data.data(), m->rows, m->cols);
+                    return result;
+                }
+            );
+
+            add_values_function(ADD_FN, {{matrix_type, false}, {matrix_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto a = as_matrix(vals[0]);
+                    auto b = as_matrix(vals[1]);
+                    same_shape(a, b);
+
+                    auto result = Interpreting::MatrixValue::create(matrix_type, a->rows, a->cols);
+                    vec_kernels::add(a->data.data(), b->data.data(), result->data.data(), a->data.size());
+                    return result;
+                }
+            );
+
+            add_values_function(SUB_FN, {{matrix_type, false}, {matrix_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto a = as_matrix(vals[0]);
+                    auto b = as_matrix(vals[1]);
+                    same_shape(a, b);
+
+                    auto result = Interpreting::MatrixValue::create(matrix_type, a->rows, a->cols);
+                    matrix_kernels::sub(a->data.data(), b->data.data(), result->data.data(), a->data.size());
+                    return result;
+                }
+            );
+
+            add_values_function(SCALE_FN, {{matrix_type, false}, {double_type, false}}, matrix_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto m = as_matrix(vals[0]);
+                    auto result = Interpreting::MatrixValue::create(matrix_type, m->rows, m->cols);
+                    vec_kernels::scale(read_number(vals[1]), m->data.data(), result->data.data(), m->data.size());
+                    return result;
+                }
+            );
+        }
+
+        std::string module_name() final { return MATRIX_MD; }
+        bool is_pure() final { return true; }
+    };
+}
+
+#endif //ODO_MATRIXMODULE_H
@@ -6,6 +6,8 @@
 #ifndef ODO_NATIVEMODULE_H
 #define ODO_NATIVEMODULE_H
 #include "Interpreter/value.h"
+#include "SemAnalyzer/NodeResult.h"
+#include "Parser/AST/Forward.h"
 
 namespace Odo::Semantics {
     class SemanticAnalyzer;
@@ -19,6 +21,7 @@ namespace Odo::Modules {
         Interpreting::Symbol* double_type;
         Interpreting::Symbol* bool_type;
         Interpreting::Symbol* string_type;
+        Interpreting::Symbol* any_type;
 
         std::weak_ptr<Semantics::SemanticAnalyzer> analyzer;
 
@@ -31,9 +34,19 @@ namespace Odo::Modules {
                           const std::vector<std::pair<Interpreting::Symbol *, bool>> &arg_types,
                           Interpreting::Symbol *ret, std::function<std::any(std::vector<std::any>)> callback);
 
+        // For functions that take or return values other than primitives.
+        // The check replaces the analysis of the arguments, and gives the type of the result of each call.
+        void add_values_function(const std::string &name,
+                          const std::vector<std::pair<Interpreting::Symbol *, bool>> &arg_types,
+                          Interpreting::Symbol *ret, Interpreting::handle_values_function_type callback,
+                          std::function<Semantics::NodeResult(const std::shared_ptr<Parsing::FuncCallNode>&)> check = nullptr);
+
     public:
         explicit NativeModule(const std::string&, Interpreting::Interpreter& inter);
         virtual std::string module_name() = 0;
+        // Functions of a pure module only depend on their arguments,
+        // so they can be called from the body of a parallel forange.
+        virtual bool is_pure() { return false; }
     };
 }
 
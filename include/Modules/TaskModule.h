@@ -0,0 +1,177 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_TASKMODULE_H
+#define ODO_TASKMODULE_H
+#include "Interpreter/Interpreter.h"
+#include "NativeModule.h"
+
+#include <chrono>
+#include <future>
+
+namespace Odo::Modules {
+    // Runs functions on the task pool of the interpreter.
+    // Each job gets its own worker interpreter, made on the calling thread before the job is queued.
+    // The arguments are copied before they're handed to a job, and results are copied when they're awaited,
+    // so no value is reachable from two threads at once.
+    // The function of a task must not outlive the scope it was declared in. The program waits for
+    // every task before it ends, but a function declared inside of another one can't be spawned
+    // and left running after that one returns.
+    class TaskModule final : public NativeModule {
+        Interpreting::Interpreter& inter;
+
+        typedef std::shared_future<Interpreting::value_t> result;
+
+        // Lets the waiting thread run queued jobs, so it doesn't sit idle.
+        template<typename T>
+        T wait_for(const std::shared_future<T>& pending) {
+            auto& pool = inter.get_task_pool();
+            while (pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                if (!pool.run_pending()) {
+                    pending.wait_for(std::chrono::milliseconds(1));
+                }
+            }
+
+            return pending.get();
+        }
+
+        // The job looks up names starting from the scope the function was declared in,
+        // while this thread can keep declaring new ones in the same scopes.
+        static void share_scopes(const std::shared_ptr<Interpreting::FunctionValue>& function) {
+            for (auto scope = function->parentScope; scope; scope = scope->getParent()) {
+                scope->share_between_threads();
+            }
+        }
+
+        result run(const std::shared_ptr<Interpreting::FunctionValue>& function, std::vector<Interpreting::value_t> args) {
+            auto& pool = inter.get_task_pool();
+            share_scopes(function);
+            std::shared_ptr<Interpreting::Interpreter> worker = inter.create_worker();
+            auto promise = std::make_shared<std::promise<Interpreting::value_t>>();
+
+            for (auto& arg : args) {
+                if (arg->is_copyable()) arg = arg->copy();
+            }
+
+            pool.submit([worker, function, promise, args = std::move(args)] {
+                try {
+                    promise->set_value(worker->call_function(function, args));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+
+            return promise->get_future().share();
+        }
+    public:
+        explicit TaskModule(Interpreting::Interpreter& inter_)
+            : NativeModule(module_name(), inter_)
+            , inter(inter_)
+        {
+            add_values_function(SPAWN_FN, {{any_type, false}}, any_type,
+                [&](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto function = Interpreting::Value::as<Interpreting::FunctionValue>(vals[0]);
+                    auto pending = run(function, {});
+
+                    // The handle is a function that waits for the result.
+                    Interpreting::handle_values_function_type get_result = [this, pending](const std::vector<Interpreting::value_t>&) {
+                        auto value = wait_for(pending);
+                        return value->is_copyable() ? value->copy() : value;
+                    };
+                    return Interpreting::NativeFunctionValue::create(function->type, {}, get_result);
+                },
+                [an = analyzer](const std::shared_ptr<Parsing::FuncCallNode>& node){ return an.lock()->check_task_spawn(node); }
+            );
+
+            add_values_function(AWAIT_FN, {{any_type, false}}, any_type,
+                [&](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto& awaited = vals[0];
+                    if (awaited->kind() == Interpreting::ValueType::FunctionVal) {
+                        return inter.call_function(Interpreting::Value::as<Interpreting::FunctionValue>(awaited), {});
+                    }
+
+                    auto as_native = Interpreting::Value::as<Interpreting::NativeFunctionValue>(awaited);
+                    if (as_native->function_kind == Interpreting::NativeFunctionValue::NativeFunctionType::Values) {
+                        return as_native->values_fn({});
+                    }
+
+                    auto value = as_native->fn({});
+                    return as_native->type->tp
+                        ? Interpreting::NormalValue::create(as_native->type->tp, value)
+                        : inter.get_null();
+                },
+                [an = analyzer](const std::shared_ptr<Parsing::FuncCallNode>& node){ return an.lock()->check_task_await(node); }
+            );
+
+            add_values_function(MAP_FN, {{any_type, false}, {any_type, false}}, any_type,
+                [&](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    auto list = Interpreting::Value::as<Interpreting::ListValue>(vals[0]);
+                    auto function = Interpreting::Value::as<Interpreting::FunctionValue>(vals[1]);
+                    auto result_type = function->type->tp;
+
+                    auto n_elements = list->elements.size();
+                    // A few chunks per thread, so the ones that finish early can steal the rest.
+                    auto n_chunks = std::min<size_t>(n_elements, inter.get_task_pool().size() * 4);
+
+                    share_scopes(function);
+                    std::vector<Interpreting::value_t> results(n_elements);
+                    std::vector<std::shared_future<void>> chunks;
+                    for (size_t chunk = 0; chunk < n_chunks; chunk++) {
+                        auto from = n_elements * chunk / n_chunks;
+                        auto to = n_elements * (chunk + 1) / n_chunks;
+
+                        std::vector<Interpreting::value_t> inputs;
+                        for (auto i = from; i < to; i++) {
+                            auto& value = list->elements[i].value;
+                            inputs.push_back(value->is_copyable() ? value->copy() : value);
+                        }
+
+                        std::shared_ptr<Interpreting::Interpreter> worker = inter.create_worker();
+                        auto done = std::make_shared<std::promise<void>>();
+                        chunks.push_back(done->get_future().share());
+
+                        inter.get_task_pool().submit([worker, function, done, from, &results, inputs = std::move(inputs)] {
+                            try {
+                                for (size_t i = 0; i < inputs.size(); i++) {
+                                    auto value = worker->call_function(function, {inputs[i]});
+                                    results[from + i] = value->is_copyable() ? value->copy() : value;
+                                }
+                                done->set_value();
+                            } catch (...) {
+                                done->set_exception(std::current_exception());
+                            }
+                        });
+                    }
+
+                    // Every chunk has to finish before returning, even if one of them failed, since they write to results.
+                    std::exception_ptr error;
+                    for (auto& chunk : chunks) {
+                        try {
+                            wait_for(chunk);
+                        } catch (...) {
+                            if (!error) error = std::current_exception();
+                        }
+                    }
+
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+
+                    std::vector<Interpreting::Symbol> elements;
+                    elements.reserve(n_elements);
+                    for (auto& value : results) {
+                        elements.push_back({value->type, "list_element", value});
+                    }
+
+                    return Interpreting::ListValue::create(inter.get_global().addListType(result_type), std::move(elements));
+                },
+                [an = analyzer](const std::shared_ptr<Parsing::FuncCallNode>& node){ return an.lock()->check_task_map(node); }
+            );
+        }
+
+        std::string module_name() final { return TASK_MD; }
+    };
+}
+
+#endif //ODO_TASKMODULE_H
@@ -0,0 +1,246 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_VECMODULE_H
+#define ODO_VECMODULE_H
+#include "Interpreter/Interpreter.h"
+#include "NativeModule.h"
+#include "Exceptions/exception.h"
+
+#include <cstddef>
+
+namespace Odo::Modules {
+    // The loops behind the vec module. They work on contiguous buffers,
+    // and are compiled once for AVX2 and once for the baseline, picked when the program loads.
+    namespace vec_kernels {
+        double sum(const double* x, size_t n);
+        long long sum(const int* x, size_t n);
+
+        double dot(const double* x, const double* y, size_t n);
+        long long dot(const int* x, const int* y, size_t n);
+
+        // out = a * x + y
+        void axpy(double a, const double* x, const double* y, double* out, size_t n);
+        void axpy(int a, const int* x, const int* y, int* out, size_t n);
+
+        void scale(double a, const double* x, double* out, size_t n);
+        void scale(int a, const int* x, int* out, size_t n);
+
+        void add(const double* x, const double* y, double* out, size_t n);
+        void add(const int* x, const int* y, int* out, size_t n);
+
+        void mul(const double* x, const double* y, double* out, size_t n);
+        void mul(const int* x, const int* y, int* out, size_t n);
+
+        // The position of the first smallest or largest element. n can't be 0.
+        size_t argmin(const double* x, size_t n);
+        size_t argmin(const int* x, size_t n);
+        size_t argmax(const double* x, size_t n);
+        size_t argmax(const int* x, size_t n);
+    }
+
+    // Numeric functions over int[] and double[].
+    // The elements are copied into a buffer before each call, so the kernels don't walk the symbols of the list.
+    // The result is an int when every argument is made of ints, and a double otherwise.
+    class VecModule final : public NativeModule {
+        Interpreting::Interpreter& inter;
+
+        typedef Semantics::SemanticAnalyzer::vec_result vec_result;
+
+        bool is_int_list(const Interpreting::value_t& value) { return value->type->tp == int_type; }
+        bool is_int(const Interpreting::value_t& value) { return value->type == int_type; }
+
+        template<typename T>
+        std::vector<T> gather(const Interpreting::value_t& value) {
+            auto& elements = Interpreting::Value::as<Interpreting::ListValue>(value)->elements;
+            std::vector<T> result;
+            result.reserve(elements.size());
+            for (auto& element : elements) {
+                auto as_normal = Interpreting::Value::as<Interpreting::NormalValue>(element.value);
+                result.push_back(is_int(as_normal) ? (T)as_normal->as_int() : (T)as_normal->as_double());
+            }
+
+            return result;
+        }
+
+        template<typename T>
+        T read(const Interpreting::value_t& value) {
+            auto as_normal = Interpreting::Value::as<Interpreting::NormalValue>(value);
+            return is_int(as_normal) ? (T)as_normal->as_int() : (T)as_normal->as_double();
+        }
+
+        // Every list given to a function has to be as long as the first one.
+        static void same_length(const std::vector<Interpreting::value_t>& lists);
+
+        static void not_empty(const Interpreting::value_t& list, const std::string& name);
+
+        Interpreting::Symbol* number_type(bool as_int) { return as_int ? int_type : double_type; }
+
+        template<typename T>
+        Interpreting::value_t number(T value) {
+            return Interpreting::NormalValue::create(number_type(std::is_same_v<T, int>), value);
+        }
+
+        template<typename T>
+        Interpreting::value_t list_of(const std::vector<T>& values) {
+            auto tp = number_type(std::is_same_v<T, int>);
+            std::vector<Interpreting::Symbol> elements;
+            elements.reserve(values.size());
+            for (auto value : values) {
+                elements.push_back({tp, "list_element", Interpreting::NormalValue::create(tp, value)});
+            }
+
+            return Interpreting::ListValue::create(inter.get_global().addListType(tp), std::move(elements));
+        }
+
+        // Adds a function that takes n_lists lists followed by n_numbers numbers,
+        // and calls for_int or for_double depending on the type of the result.
+        template<typename IntFn, typename DoubleFn>
+        void add_vec_function(const std::string& name, size_t n_lists, size_t n_numbers, vec_result result, IntFn for_int, DoubleFn for_double) {
+            std::vector<std::pair<Interpreting::Symbol*, bool>> args(n_lists + n_numbers, {any_type, false});
+
+            add_values_function(name, args, any_type,
+                [=, this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    std::vector<Interpreting::value_t> lists(vals.begin(), vals.begin() + (long)n_lists);
+                    same_length(lists);
+
+                    bool as_int = true;
+                    for (size_t i = 0; i < vals.size(); i++) {
+                        as_int = as_int && (i < n_lists ? is_int_list(vals[i]) : is_int(vals[i]));
+                    }
+
+                    return as_int ? for_int(vals) : for_double(vals);
+                },
+                [an = analyzer, n_lists, n_numbers, result](const std::shared_ptr<Parsing::FuncCallNode>& node){
+                    return an.lock()->check_vec_call(node, n_lists, n_numbers, result);
+                }
+            );
+        }
+
+        template<typename T>
+        Interpreting::value_t reduce_sum(const std::vector<Interpreting::value_t>& vals) {
+            auto x = gather<T>(vals[0]);
+            auto total = vec_kernels::sum(x.data(), x.size());
+            return number<T>((T)total);
+        }
+
+        template<typename T>
+        Interpreting::value_t reduce_dot(const std::vector<Interpreting::value_t>& vals) {
+            auto x = gather<T>(vals[0]);
+            auto y = gather<T>(vals[1]);
+            auto total = vec_kernels::dot(x.data(), y.data(), x.size());
+            return number<T>((T)total);
+        }
+
+        template<typename T>
+        Interpreting::value_t elementwise(const std::vector<Interpreting::value_t>& vals, void (*kernel)(const T*, const T*, T*, size_t)) {
+            auto x = gather<T>(vals[0]);
+            auto y = gather<T>(vals[1]);
+            std::vector<T> out(x.size());
+            kernel(x.data(), y.data(), out.data(), x.size());
+            return list_of(out);
+        }
+
+        template<typename T>
+        Interpreting::value_t scaled(const std::vector<Interpreting::value_t>& vals) {
+            auto x = gather<T>(vals[0]);
+            std::vector<T> out(x.size());
+            vec_kernels::scale(read<T>(vals[1]), x.data(), out.data(), x.size());
+            return list_of(out);
+        }
+
+        template<typename T>
+        Interpreting::value_t axpy(const std::vector<Interpreting::value_t>& vals) {
+            auto x = gather<T>(vals[0]);
+            auto y = gather<T>(vals[1]);
+            std::vector<T> out(x.size());
+            vec_kernels::axpy(read<T>(vals[2]), x.data(), y.data(), out.data(), x.size());
+            return list_of(out);
+        }
+
+        template<typename T>
+        size_t position(const std::vector<Interpreting::value_t>& vals, const std::string& name, bool largest) {
+            not_empty(vals[0], name);
+            auto x = gather<T>(vals[0]);
+            return largest ? vec_kernels::argmax(x.data(), x.size()) : vec_kernels::argmin(x.data(), x.size());
+        }
+
+        template<typename T>
+        Interpreting::value_t extreme(const std::vector<Interpreting::value_t>& vals, const std::string& name, bool largest) {
+            auto& elements = Interpreting::Value::as<Interpreting::ListValue>(vals[0])->elements;
+            return number<T>(read<T>(elements[position<T>(vals, name, largest)].value));
+        }
+
+        Interpreting::value_t map_native(const Interpreting::value_t& list, const Interpreting::value_t& function_value);
+    public:
+        explicit VecModule(Interpreting::Interpreter& inter_)
+            : NativeModule(module_name(), inter_)
+            , inter(inter_)
+        {
+            add_vec_function(SUM_FN, 1, 0, vec_result::Number,
+                [this](auto& vals){ return reduce_sum<int>(vals); },
+                [this](auto& vals){ return reduce_sum<double>(vals); }
+            );
+
+            add_vec_function(DOT_FN, 2, 0, vec_result::Number,
+                [this](auto& vals){ return reduce_dot<int>(vals); },
+                [this](auto& vals){ return reduce_dot<double>(vals); }
+            );
+
+            add_vec_function(AXPY_FN, 2, 1, vec_result::List,
+                [this](auto& vals){ return axpy<int>(vals); },
+                [this](auto& vals){ return axpy<double>(vals); }
+            );
+
+            add_vec_function(SCALE_FN, 1, 1, vec_result::List,
+                [this](auto& vals){ return scaled<int>(vals); },
+                [this](auto& vals){ return scaled<double>(vals); }
+            );
+
+            add_vec_function(ADD_FN, 2, 0, vec_result::List,
+                [this](auto& vals){ return elementwise<int>(vals, vec_kernels::add); },
+                [this](auto& vals){ return elementwise<double>(vals, vec_kernels::add); }
+            );
+
+            add_vec_function(MUL_FN, 2, 0, vec_result::List,
+                [this](auto& vals){ return elementwise<int>(vals, vec_kernels::mul); },
+                [this](auto& vals){ return elementwise<double>(vals, vec_kernels::mul); }
+            );
+
+            add_vec_function(MIN_FN, 1, 0, vec_result::Number,
+                [this](auto& vals){ return extreme<int>(vals, MIN_FN, false); },
+                [this](auto& vals){ return extreme<double>(vals, MIN_FN, false); }
+            );
+
+            add_vec_function(MAX_FN, 1, 0, vec_result::Number,
+                [this](auto& vals){ return extreme<int>(vals, MAX_FN, true); },
+                [this](auto& vals){ return extreme<double>(vals, MAX_FN, true); }
+            );
+
+            add_vec_function(ARGMIN_FN, 1, 0, vec_result::Index,
+                [this](auto& vals){ return number<int>((int)position<int>(vals, ARGMIN_FN, false)); },
+                [this](auto& vals){ return number<int>((int)position<double>(vals, ARGMIN_FN, false)); }
+            );
+
+            add_vec_function(ARGMAX_FN, 1, 0, vec_result::Index,
+                [this](auto& vals){ return number<int>((int)position<int>(vals, ARGMAX_FN, true)); },
+                [this](auto& vals){ return number<int>((int)position<double>(vals, ARGMAX_FN, true)); }
+            );
+
+            // Only takes functions of native modules, like the ones in math,
+            // so calling it can't change anything and the module stays pure.
+            add_values_function(MAP_FN, {{any_type, false}, {any_type, false}}, any_type,
+                [this](const std::vector<Interpreting::value_t>& vals) -> Interpreting::value_t {
+                    return map_native(vals[0], vals[1]);
+                },
+                [an = analyzer](const std::shared_ptr<Parsing::FuncCallNode>& node){ return an.lock()->check_vec_map(node); }
+            );
+        }
+
+        std::string module_name() final { return VEC_MD; }
+        bool is_pure() final { return true; }
+    };
+}
+
+#endif //ODO_VECMODULE_H
@@ -0,0 +1,17 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_KERNEL_H
+#define ODO_KERNEL_H
+
+// The loops of the vec and matrix modules are built once for AVX2 and once for the baseline,
+// and the loader picks one for the running cpu. That needs ifunc support, which
+// Windows and the Mach-O binaries of macOS don't have, so they only get the baseline.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(_WIN32) && !defined(__APPLE__)
+#define ODO_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define ODO_KERNEL
+#endif
+
+#endif //ODO_KERNEL_H
@@ -10,6 +10,8 @@ struct FoRangeNode final : public Node {
     std::shared_ptr<Parsing::Node> second;
     std::shared_ptr<Parsing::Node> body;
     Lexing::Token rev;
+    // Iterations may run concurrently. The analyzer checks that they don't depend on each other.
+    bool parallel = false;
     
     NodeType kind() final { return NodeType::FoRange; }
 
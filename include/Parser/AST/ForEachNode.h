@@ -9,6 +9,8 @@ struct ForEachNode final : public Node {
     std::shared_ptr<Parsing::Node> lst;
     std::shared_ptr<Parsing::Node> body;
     Lexing::Token rev;
+    // Set when iterating over the entries of a map, for the variable that gets each value.
+    Lexing::Token value_var{Lexing::NOTHING, ""};
     
     NodeType kind() final { return NodeType::ForEach; }
 
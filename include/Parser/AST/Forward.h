@@ -48,5 +48,7 @@ namespace Odo::Parsing {
     struct MemberVarNode;
     struct StaticVarNode;
     struct IndexNode;
+    struct MapTypeNode;
+    struct MapExpressionNode;
 }
 #endif //ODO_FORWARD_H
@@ -0,0 +1,19 @@
+
+#pragma once
+
+#include "Parser/AST/Node.h"
+
+namespace Odo::Parsing {
+struct MapExpressionNode final : public Node {
+    std::vector<std::shared_ptr<Parsing::Node>> keys;
+    std::vector<std::shared_ptr<Parsing::Node>> values;
+    
+    NodeType kind() final { return NodeType::MapExpression; }
+
+    MapExpressionNode(std::vector<std::shared_ptr<Parsing::Node>> keys_p, std::vector<std::shared_ptr<Parsing::Node>> values_p);
+
+    static std::shared_ptr<Node> create(std::vector<std::shared_ptr<Parsing::Node>> keys_p, std::vector<std::shared_ptr<Parsing::Node>> values_p){
+        return std::make_shared<MapExpressionNode>(std::move(keys_p), std::move(values_p));
+    }
+};
+}
@@ -0,0 +1,19 @@
+
+#pragma once
+
+#include "Parser/AST/Node.h"
+
+namespace Odo::Parsing {
+struct MapTypeNode final : public Node {
+    std::shared_ptr<Parsing::Node> key_type;
+    std::shared_ptr<Parsing::Node> value_type;
+    
+    NodeType kind() final { return NodeType::MapType; }
+
+    MapTypeNode(std::shared_ptr<Parsing::Node> key_type_p, std::shared_ptr<Parsing::Node> value_type_p);
+
+    static std::shared_ptr<Node> create(std::shared_ptr<Parsing::Node> key_type_p, std::shared_ptr<Parsing::Node> value_type_p){
+        return std::make_shared<MapTypeNode>(std::move(key_type_p), std::move(value_type_p));
+    }
+};
+}
@@ -30,6 +30,8 @@ namespace Odo::Parsing {
         Assignment,
 
         ListExpression,
+        MapExpression,
+        MapType,
         Block,
         FuncExpression,
         FuncDecl,
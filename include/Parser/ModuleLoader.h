@@ -0,0 +1,43 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#ifndef ODO_MODULELOADER_H
+#define ODO_MODULELOADER_H
+
+#include "AST/Node.h"
+
+#include <exception>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Odo::Parsing {
+    // Reads and parses module files once, so the analyzer and the interpreter share the same tree.
+    // The import graph of a program can be discovered up front with preload, which parses the
+    // modules of each level of the graph concurrently. Analysis and execution still happen
+    // in import order, so the result does not depend on which file finished parsing first.
+    // Parsed modules are only kept for one run, so a file edited between runs is read again.
+    class ModuleLoader {
+        struct parsed_module {
+            std::vector<std::shared_ptr<Node>> body;
+            // Set if the file could not be read or parsed. Rethrown when the module is requested.
+            std::exception_ptr error;
+        };
+
+        std::unordered_map<std::string, parsed_module> modules;
+
+        static parsed_module parse(const std::string& full_path);
+        static void collect_imports(const std::vector<std::shared_ptr<Node>>&, std::vector<std::string>&);
+    public:
+        static std::string full_path(const std::string& path);
+
+        void preload(const std::shared_ptr<Node>& program);
+
+        std::vector<std::shared_ptr<Node>> get(const std::string& full_path);
+
+        void clear();
+    };
+}
+
+#endif //ODO_MODULELOADER_H
@@ -10,6 +10,8 @@
 
 #include "Translations/lang.h"
 
+#include <set>
+
 #include "Parser/AST/DoubleNode.h"
 #include "Parser/AST/IntNode.h"
 #include "Parser/AST/BoolNode.h"
@@ -23,6 +25,8 @@
 #include "Parser/AST/VariableNode.h"
 #include "Parser/AST/AssignmentNode.h"
 #include "Parser/AST/ListExpressionNode.h"
+#include "Parser/AST/MapExpressionNode.h"
+#include "Parser/AST/MapTypeNode.h"
 #include "Parser/AST/BlockNode.h"
 #include "Parser/AST/FuncExpressionNode.h"
 #include "Parser/AST/FuncDeclNode.h"
@@ -92,6 +96,7 @@ namespace Odo::Semantics {
         // Dangerous. What happens when a nested one throws?
         void push_lazy_scope();
         void pop_lazy_scope();
+        void drop_lazy(Interpreting::Symbol*);
 
         bool inside_loop{false};
 
@@ -99,6 +104,7 @@ namespace Odo::Semantics {
         Interpreting::Symbol* accepted_return_type {nullptr};
 
         Interpreting::Symbol* accepted_list_type{nullptr};
+        Interpreting::Symbol* accepted_map_type{nullptr};
 
         Interpreting::SymbolTable* add_semantic_context(Interpreting::Symbol*, std::string);
         Interpreting::SymbolTable* get_semantic_context(Interpreting::Symbol*);
@@ -107,6 +113,55 @@ namespace Odo::Semantics {
 
         std::map<std::string, NodeResult> native_function_data;
 
+    public:
+        typedef std::function<NodeResult(const std::shared_ptr<Parsing::FuncCallNode>&)> call_check;
+    private:
+        // For natives whose result type depends on the types of their arguments.
+        // Found by the value of the function, since the module's scope is copied for the analysis.
+        std::map<Interpreting::Value*, call_check> call_checks;
+
+        // Types from native modules that foreach can go through, and the type of their elements.
+        std::map<Interpreting::Symbol*, Interpreting::Symbol*> iterable_types;
+
+        // What check_parallel_body knows about the statements it has walked so far.
+        struct parallel_context {
+            // Starts the message of the errors found.
+            std::string subject = NOT_PARALLEL_EXCP;
+            std::string iterator;
+            bool in_function = false;
+            int loop_depth = 0;
+            // Names declared inside of the loop body, or inside of a called function.
+            std::vector<std::set<std::string>> locals{};
+            // List parameters of the function being checked. They reference the caller's list.
+            std::set<std::string> list_params{};
+
+            // Uses of a list declared outside of the loop. `levels` are the index positions
+            // that are exactly the loop iterator. `whole` means it was used without indexing.
+            struct list_use {
+                std::string name;
+                std::set<size_t> levels;
+                bool whole;
+                std::shared_ptr<Parsing::Node> node;
+            };
+            std::vector<list_use> uses{};
+            std::set<std::string> written{};
+            std::set<std::string> read_by_functions{};
+            std::set<Parsing::Node*> checked_functions{};
+        };
+        std::map<Interpreting::Symbol*, std::shared_ptr<Parsing::FuncDeclNode>> function_declarations;
+
+        void check_parallel_body(const std::shared_ptr<Parsing::FoRangeNode>&);
+        void check_parallel_node(const std::shared_ptr<Parsing::Node>&, parallel_context&);
+        void check_parallel_call(const std::shared_ptr<Parsing::FuncCallNode>&, parallel_context&);
+        void check_parallel_function(const std::shared_ptr<Parsing::FuncDeclNode>&, parallel_context&);
+        void check_parallel_index(const std::shared_ptr<Parsing::IndexNode>&, parallel_context&, bool is_write);
+
+        // The function given to a task must be safe to run while the caller keeps going.
+        // Returns its type.
+        // Gives the type of the elements for lists, and the type of the number otherwise.
+        NodeResult check_vec_arg(const std::shared_ptr<Parsing::FuncCallNode>&, size_t index, bool is_list);
+        Interpreting::Symbol* check_task_function(const std::shared_ptr<Parsing::FuncCallNode>& call, const std::shared_ptr<Parsing::Node>& function, size_t n_arguments);
+
         ADD_VISITOR(Double);
         ADD_VISITOR(Int);
         ADD_VISITOR(Str);
@@ -133,6 +188,7 @@ namespace Odo::Semantics {
         ADD_VISITOR(Assignment);
 
         ADD_VISITOR(ListExpression);
+        ADD_VISITOR(MapExpression);
 
         ADD_VISITOR(FuncExpression);
         ADD_VISITOR(FuncDecl);
@@ -161,6 +217,8 @@ namespace Odo::Semantics {
 
         Interpreting::Symbol* string_to_list_type(const std::string&);
         Interpreting::Symbol* handle_list_type(Interpreting::Symbol*, int dimensions = 1);
+        void check_map_key(Interpreting::Symbol* map_type, const NodeResult& key, const std::shared_ptr<Parsing::Node>& node);
+        Interpreting::Symbol* handle_map_type(Interpreting::Symbol* key, Interpreting::Symbol* value, const std::shared_ptr<Parsing::Node>& node);
 
         Interpreting::Symbol *getSymbolFromNode(const std::shared_ptr<Parsing::Node>& mem);
         Interpreting::Symbol* getStaticFromClass(Interpreting::Symbol*, const std::shared_ptr<Parsing::StaticVarNode>&);
@@ -174,9 +232,29 @@ namespace Odo::Semantics {
         Interpreting::SymbolTable* add_semantic_context(Interpreting::Symbol*, Interpreting::SymbolTable);
 
         std::map<Interpreting::Symbol*, arg_types>& get_function_context_map() { return functions_context; }
+        void add_call_check(Interpreting::Value* function, call_check check) { call_checks[function] = std::move(check); }
+        void add_iterable_type(Interpreting::Symbol* type, Interpreting::Symbol* element_type) { iterable_types[type] = element_type; }
+
+        NodeResult check_task_spawn(const std::shared_ptr<Parsing::FuncCallNode>&);
+        NodeResult check_task_await(const std::shared_ptr<Parsing::FuncCallNode>&);
+        NodeResult check_task_map(const std::shared_ptr<Parsing::FuncCallNode>&);
+
+        // What a function of the vec module gives back: a number of the type of its arguments,
+        // a position in the list, or a list of numbers.
+        enum class vec_result {
+            Number,
+            Index,
+            List
+        };
+        NodeResult check_vec_call(const std::shared_ptr<Parsing::FuncCallNode>&, size_t n_lists, size_t n_numbers, vec_result);
+        NodeResult check_vec_map(const std::shared_ptr<Parsing::FuncCallNode>&);
 
         NodeResult visit(const std::shared_ptr<Parsing::Node>&);
         NodeResult from_repl(const std::shared_ptr<Parsing::Node>&);
+        // Undoes the declaration made by a repl statement that failed at runtime,
+        // so the analyzer and the interpreter agree on what exists.
+        // Returns the name that was declared, or an empty string.
+        std::string forget_repl_declaration(const std::shared_ptr<Parsing::Node>&);
     };
 }
 
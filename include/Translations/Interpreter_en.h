@@ -12,6 +12,7 @@
 #define DOUBLE_TP "double"
 #define STRING_TP "string"
 #define BOOL_TP "bool"
+#define MAP_TP "map"
 #define POINTER_TP "pointer"
 
 // Variables
@@ -36,19 +37,43 @@
 #define READ_FN "read"
 #define READ_INT_FN "read_int"
 #define READ_DOUBLE_FN "read_double"
+#define READ_ALL_INTS_FN "read_all_ints"
+#define READ_LINES_FN "read_lines"
 #define RAND_FN "rand"
 #define RAND_INT_FN "randInt"
 #define POP_FN "pop"
 #define PUSH_FN "push"
 #define TYPEOF_FN "typeof"
+#define SORT_FN "sort"
+#define BINARY_SEARCH_FN "binary_search"
+#define REVERSE_FN "reverse"
 #define CLEAR_FN "clear"
 #define WAIT_FN "wait"
+#define FLUSH_FN "flush"
 #define SLEEP_FN "sleep"
+#define GC_COLLECT_FN "gc_collect"
+#define HEAP_STATS_FN "heap_stats"
+#define HEAP_SNAPSHOT_FN "heap_snapshot"
+
+// Keys of the map from HEAP_STATS_FN
+#define HEAP_LISTS_KEY "lists"
+#define HEAP_MAPS_KEY "maps"
+#define HEAP_INSTANCES_KEY "instances"
+#define HEAP_CLASSES_KEY "classes"
+#define HEAP_COLLECTIONS_KEY "collections"
+#define HEAP_FULL_COLLECTIONS_KEY "full_collections"
+#define HEAP_RECLAIMED_OBJECTS_KEY "reclaimed_objects"
+#define HEAP_RECLAIMED_BYTES_KEY "reclaimed_bytes"
 
 // Exceptions
 #define NOT_IMPL_EXCP "Using function not yet implemented: "
 #define FACTR_REQ_INT_EXCP "factorial function requires a single int argument."
 #define LENGTH_REQ_ARGS_EXCP "length function requires a single argument of type string or list."
+#define SORT_REQ_ARGS_EXCP "sort function requires a list and an optional comparison function."
+#define BIN_SEARCH_REQ_ARGS_EXCP "binary_search function requires a sorted list, a value and an optional comparison function."
+#define REVERSE_REQ_LIST_EXCP "reverse function requires a single argument of type list."
+#define NOT_COMPARABLE_EXCP "Only numbers and strings can be compared without a comparison function."
+#define CMP_MUST_RETURN_BOOL_EXCP "A comparison function has to return a bool value."
 #define FLOOR_ONLY_NUM_EXCP "floor function can only be called with numeric values"
 #define TRUNC_ONLY_NUM_EXCP "trunc function can only be called with numeric values"
 #define ROUND_ONLY_NUM_EXCP "round function can only be called with numeric values and an optional int"
@@ -58,7 +83,7 @@
 #define COND_IF_MUST_BOOL_EXCP "Condition of if statement must be boolean."
 #define COND_FOR_MUST_BOOL_EXCP "Condition expression of for statement must be boolean."
 #define COND_WHILE_MUST_BOOL_EXCP "Condition expression of for statement must be boolean."
-#define FOREACH_ONLY_LIST_STR_EXCP "foreach statement can only be used with list or string values."
+#define FOREACH_ONLY_LIST_STR_EXCP "foreach statement can only be used with list, string or map values."
 #define VAL_RANGE_NUM_EXCP "Values defining the range of forange statement have to be numerical"
 #define VAR_CALLED_EXCP "Variable called '"
 #define ALR_EXISTS_EXCP "' already exists"
@@ -69,8 +94,9 @@
 #define INDX_STR_OB_EXCP "Indexing a string out of bounds."
 #define STR_ONLY_INDX_NUM_EXCP "Strings can only be indexed with integer values."
 #define INDX_LST_OB_EXCP "Indexing a list out of bounds."
+#define MAP_NO_KEY_EXCP "The map has no key '"
 #define LST_ONLY_INDX_NUM_EXCP "Lists can only be indexed with integer values."
-#define INDX_ONLY_LST_STR_EXCP "Index operator is only valid for strings and lists values."
+#define INDX_ONLY_LST_STR_EXCP "Index operator is only valid for string, list and map values."
 #define ADD_ONLY_SAME_TP_EXCP "Addition operation can only be used with values of the same type."
 #define SUB_ONLY_SAME_TP_EXCP "Numeric substraction can only be used with values of the same type."
 #define MUL_ONLY_SAME_TP_EXCP "Multiplication operation can only be used with values of the same type."
@@ -13,6 +13,7 @@
 #define DOUBLE_TP "doble"
 #define STRING_TP "cadena"
 #define BOOL_TP "bool"
+#define MAP_TP "mapa"
 #define POINTER_TP "puntero"
 
 // Variables
@@ -42,19 +43,43 @@
 #define READ_FN "leer"
 #define READ_INT_FN "leer_ent"
 #define READ_DOUBLE_FN "leer_doble"
+#define READ_ALL_INTS_FN "leer_todos_ent"
+#define READ_LINES_FN "leer_lineas"
 #define RAND_FN "azar"
 #define RAND_INT_FN "azarEnt"
 #define POP_FN "retirar"
 #define PUSH_FN "apilar"
 #define TYPEOF_FN "tipode"
+#define SORT_FN "ordenar"
+#define BINARY_SEARCH_FN "busqueda_binaria"
+#define REVERSE_FN "invertir"
 #define CLEAR_FN "limpiar"
 #define WAIT_FN "esperar"
+#define FLUSH_FN "vaciar"
 #define SLEEP_FN "dormir"
+#define GC_COLLECT_FN "recolectar"
+#define HEAP_STATS_FN "estadisticas_memoria"
+#define HEAP_SNAPSHOT_FN "captura_memoria"
+
+// Keys of the map from HEAP_STATS_FN
+#define HEAP_LISTS_KEY "listas"
+#define HEAP_MAPS_KEY "mapas"
+#define HEAP_INSTANCES_KEY "instancias"
+#define HEAP_CLASSES_KEY "clases"
+#define HEAP_COLLECTIONS_KEY "recolecciones"
+#define HEAP_FULL_COLLECTIONS_KEY "recolecciones_completas"
+#define HEAP_RECLAIMED_OBJECTS_KEY "objetos_liberados"
+#define HEAP_RECLAIMED_BYTES_KEY "bytes_liberados"
 
 // Exceptions
 #define NOT_IMPL_EXCP "Usando una funcion que aun no ha sido implementada: "
 #define FACTR_REQ_INT_EXCP "La funcion '" FACTR_FN "' necesita un unico argumento tipo ent."
 #define LENGTH_REQ_ARGS_EXCP "La funcion '" LENGTH_FN "' necesita un unico argumento tipo lista o " STRING_TP "."
+#define SORT_REQ_ARGS_EXCP "La funcion '" SORT_FN "' necesita una lista y una funcion de comparacion opcional."
+#define BIN_SEARCH_REQ_ARGS_EXCP "La funcion '" BINARY_SEARCH_FN "' necesita una lista ordenada, un valor y una funcion de comparacion opcional."
+#define REVERSE_REQ_LIST_EXCP "La funcion '" REVERSE_FN "' necesita un unico argumento tipo lista."
+#define NOT_COMPARABLE_EXCP "Solo numeros y valores " STRING_TP " pueden ser comparados sin una funcion de comparacion."
+#define CMP_MUST_RETURN_BOOL_EXCP "Una funcion de comparacion debe devolver un valor tipo '" BOOL_TP "'."
 #define FLOOR_ONLY_NUM_EXCP "La funcion '" FLOOR_FN "' solo puede ser llamada con valores numericos"
 #define TRUNC_ONLY_NUM_EXCP "La funcion '" TRUNC_FN "' solo puede ser llamada con valores numericos"
 #define ROUND_ONLY_NUM_EXCP "La funcion '" ROUND_FN "' solo puede ser llamada con valores numericos y un ent opcional"
@@ -64,7 +89,7 @@
 #define COND_IF_MUST_BOOL_EXCP "La condicion de una sentencia '" IF_TK "' debe tener tipo '" BOOL_TP "'."
 #define COND_FOR_MUST_BOOL_EXCP "La condicion de una sentencia '" FOR_TK "' debe tener tipo '" BOOL_TP "'."
 #define COND_WHILE_MUST_BOOL_EXCP "La condicion de una sentencia '" WHILE_TK "' debe tener tipo '" BOOL_TP "'."
-#define FOREACH_ONLY_LIST_STR_EXCP "La sentencia '" FOREACH_TK "' solo puede ser usada con valores de lista o " STRING_TP "."
+#define FOREACH_ONLY_LIST_STR_EXCP "La sentencia '" FOREACH_TK "' solo puede ser usada con valores de lista, " STRING_TP " o " MAP_TP "."
 #define VAL_RANGE_NUM_EXCP "Los valores que definen el rango de una sentencia '" FORANGE_TK "' deben ser numericos"
 #define VAR_CALLED_EXCP "Una variable llamada '"
 #define ALR_EXISTS_EXCP "' ya existe."
@@ -75,8 +100,9 @@
 #define INDX_STR_OB_EXCP "Indexando una " STRING_TP " fuera de sus limites."
 #define STR_ONLY_INDX_NUM_EXCP STRING_TP " solo puede ser indexada con valores numericos."
 #define INDX_LST_OB_EXCP "Indexando una lista fuera de sus limites."
+#define MAP_NO_KEY_EXCP "El mapa no tiene la llave '"
 #define LST_ONLY_INDX_NUM_EXCP "Listas solo pueden ser indexadas con valores numericos."
-#define INDX_ONLY_LST_STR_EXCP "El operador de indice solo puede ser usado con valores de lista o " STRING_TP "."
+#define INDX_ONLY_LST_STR_EXCP "El operador de indice solo puede ser usado con valores de lista, " STRING_TP " o " MAP_TP "."
 #define ADD_ONLY_SAME_TP_EXCP "La operacion de suma solo puede ser usada con valores del mismo tipo."
 #define SUB_ONLY_SAME_TP_EXCP "La operacion de resta solo puede ser usada con valores del mismo tipo."
 #define MUL_ONLY_SAME_TP_EXCP "La operacion de multiplicacion solo puede ser usada con valores del mismo tipo."
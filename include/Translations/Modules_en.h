@@ -7,6 +7,19 @@
 #define ODO_MODULES_EN_H
 
 #define IO_MD "io"
+#define FILE_TP "file"
+#define OPEN_FN "open"
+#define READ_LINE_FN "read_line"
+#define AT_END_FN "at_end"
+#define CLOSE_FN "close"
+#define LINES_FN "lines"
+#define FILE_READ_MODE "r"
+#define FILE_WRITE_MODE "w"
+#define FILE_APPEND_MODE "a"
+#define FILE_MODE_EXCP "The mode of a file must be '" FILE_READ_MODE "', '" FILE_WRITE_MODE "' or '" FILE_APPEND_MODE "', but got '"
+#define FILE_CLOSED_EXCP "The file is already closed: '"
+#define FILE_NOT_READABLE_EXCP "The file wasn't opened for reading: '"
+#define FILE_NOT_WRITABLE_EXCP "The file wasn't opened for writing: '"
 
 #define MATH_MD "math"
 #define E_CONST "e"
@@ -14,4 +27,44 @@
 #define TAU_CONST "tau"
 #define EXP_FN "exp"
 
+#define TASK_MD "task"
+#define SPAWN_FN "spawn"
+#define AWAIT_FN "await"
+#define MAP_FN "map"
+
+#define VEC_MD "vec"
+#define SUM_FN "sum"
+#define DOT_FN "dot"
+#define AXPY_FN "axpy"
+#define SCALE_FN "scale"
+#define ADD_FN "add"
+#define MUL_FN "mul"
+#define MIN_FN "min"
+#define MAX_FN "max"
+#define ARGMIN_FN "argmin"
+#define ARGMAX_FN "argmax"
+#define VEC_LENGTHS_EXCP "The lists given to a function of '" VEC_MD "' must have the same length."
+#define VEC_EMPTY_EXCP "An empty list has no result for '" VEC_MD "::"
+#define VEC_MAP_NATIVE_EXCP "'" VEC_MD "::" MAP_FN "' only takes functions of native modules, like '" MATH_MD "::" SQRT_FN "'."
+
+#define MATRIX_MD "matrix"
+#define MATRIX_TP "matrix"
+#define FROM_LIST_FN "from_list"
+#define TO_LIST_FN "to_list"
+#define ZEROS_FN "zeros"
+#define IDENTITY_FN "identity"
+#define ROWS_FN "rows"
+#define COLS_FN "cols"
+#define GET_FN "get"
+#define MATMUL_FN "matmul"
+#define TRANSPOSE_FN "transpose"
+#define SUB_FN "sub"
+#define MATRIX_NEGATIVE_SIZE_EXCP "The size of a matrix can't be negative."
+#define MATRIX_RAGGED_EXCP "Every row of a matrix must have the same length."
+#define MATRIX_SHAPES_EXCP "The matrices must have the same size, but got "
+#define MATRIX_MATMUL_EXCP "The columns of the first matrix must match the rows of the second one, but got "
+#define MATRIX_AND_EXCP " and "
+#define MATRIX_INDEX_EXCP "There's no element at "
+#define MATRIX_IN_EXCP " in a matrix of "
+
 #endif //ODO_MODULES_EN_H
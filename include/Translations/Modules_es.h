@@ -7,6 +7,19 @@
 #define ODO_MODULES_EN_H
 
 #define IO_MD "es"
+#define FILE_TP "archivo"
+#define OPEN_FN "abrir"
+#define READ_LINE_FN "leer_linea"
+#define AT_END_FN "al_final"
+#define CLOSE_FN "cerrar"
+#define LINES_FN "lineas"
+#define FILE_READ_MODE "r"
+#define FILE_WRITE_MODE "w"
+#define FILE_APPEND_MODE "a"
+#define FILE_MODE_EXCP "El modo de un archivo debe ser '" FILE_READ_MODE "', '" FILE_WRITE_MODE "' o '" FILE_APPEND_MODE "', pero se recibio '"
+#define FILE_CLOSED_EXCP "El archivo ya esta cerrado: '"
+#define FILE_NOT_READABLE_EXCP "El archivo no fue abierto para leer: '"
+#define FILE_NOT_WRITABLE_EXCP "El archivo no fue abierto para escribir: '"
 
 #define MATH_MD "mate"
 #define E_CONST "e"
@@ -14,4 +27,44 @@
 #define TAU_CONST "tau"
 #define EXP_FN "exp"
 
+#define TASK_MD "tarea"
+#define SPAWN_FN "lanzar"
+#define AWAIT_FN "esperar"
+#define MAP_FN "mapear"
+
+#define VEC_MD "vec"
+#define SUM_FN "sumatoria"
+#define DOT_FN "producto_punto"
+#define AXPY_FN "axpy"
+#define SCALE_FN "escalar"
+#define ADD_FN "sumar"
+#define MUL_FN "multiplicar"
+#define MIN_FN "min"
+#define MAX_FN "max"
+#define ARGMIN_FN "argmin"
+#define ARGMAX_FN "argmax"
+#define VEC_LENGTHS_EXCP "Las listas pasadas a una funcion de '" VEC_MD "' deben tener el mismo largo."
+#define VEC_EMPTY_EXCP "Una lista vacia no tiene resultado para '" VEC_MD "::"
+#define VEC_MAP_NATIVE_EXCP "'" VEC_MD "::" MAP_FN "' solo acepta funciones de modulos nativos, como '" MATH_MD "::" SQRT_FN "'."
+
+#define MATRIX_MD "matriz"
+#define MATRIX_TP "matriz"
+#define FROM_LIST_FN "de_lista"
+#define TO_LIST_FN "a_lista"
+#define ZEROS_FN "ceros"
+#define IDENTITY_FN "identidad"
+#define ROWS_FN "filas"
+#define COLS_FN "columnas"
+#define GET_FN "obtener"
+#define MATMUL_FN "producto"
+#define TRANSPOSE_FN "transpuesta"
+#define SUB_FN "restar"
+#define MATRIX_NEGATIVE_SIZE_EXCP "El tamano de una matriz no puede ser negativo."
+#define MATRIX_RAGGED_EXCP "Todas las filas de una matriz deben tener el mismo largo."
+#define MATRIX_SHAPES_EXCP "Las matrices deben tener el mismo tamano, pero se recibieron "
+#define MATRIX_MATMUL_EXCP "Las columnas de la primera matriz deben coincidir con las filas de la segunda, pero se recibieron "
+#define MATRIX_AND_EXCP " y "
+#define MATRIX_INDEX_EXCP "No hay un elemento en "
+#define MATRIX_IN_EXCP " en una matriz de "
+
 #endif //ODO_MODULES_EN_H
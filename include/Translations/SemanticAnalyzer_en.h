@@ -9,6 +9,12 @@
 #define BOTH_BRANCH_SAME_TYPE_EXCP "Both branches in ternary operator must return the same type."
 #define BRANCHES_MUST_RETURN_EXCP "Ternary operator branches must be valid expressions. (Must return value)"
 #define LST_EL_NO_VALUE_EXCP "Element in list has no value."
+#define MAP_EL_NO_VALUE_EXCP "Key or value in map has no value."
+#define MAP_KEY_TYPE_EXCP "The keys of a map can only be " INT_TP ", " DOUBLE_TP ", " STRING_TP " or " BOOL_TP " values, not "
+#define MAP_KEYS_SAME_TYPE_EXCP "Every key in a map literal has to be of the same type."
+#define MAP_INDX_KEY_EXCP "This map can only be indexed with keys of type "
+#define FOREACH_VALUE_ONLY_MAP_EXCP "Only the entries of a map have a value to iterate along with the key."
+#define FOREACH_ONLY_FORWARD_EXCP "The lines of a file can only be iterated from the start."
 #define NOTHING_TO_ITERATE_EXCP "Nothing to iterate over in foreach statement"
 #define INVALID_DECL_TYPE_EXCP "Invalid declaration. Initializing variable of type "
 #define WITH_VAL_OF_TYPE_EXCP " with value of type "
@@ -61,4 +67,27 @@
 #define SYM_IN_FUNC_DEF_EXCP "Symbol in function type definition '"
 #define IS_NOT_TP_EXCP "' is not a type."
 
+#define NOT_PARALLEL_EXCP "The iterations of this '" PARALLEL_TK " " FORANGE_TK "' are not independent: "
+#define PAR_ORDER_EXCP "it contains a statement that depends on the order of the iterations."
+#define PAR_ASSIGNS_OUTER_EXCP "it assigns to a variable declared outside of the loop: '"
+#define PAR_REDECLARES_ITER_EXCP "it declares a new variable with the name of the iterator '"
+#define PAR_LIST_INDEX_EXCP "every use of the list '"
+#define PAR_BY_ITERATOR_EXCP "' has to be indexed by the loop iterator, in the same position."
+#define PAR_LIST_IN_FUNC_EXCP "a function called in the loop reads the list it writes: '"
+#define PAR_CALLS_EXCP "it calls '"
+#define PAR_SIDE_EFFECTS_EXCP "', which can have side effects."
+#define PAR_ON_OUTER_LIST_EXCP "' on a list declared outside of the loop."
+#define PAR_WRITES_MAP_EXCP "it writes to a map declared outside of the loop: '"
+
+#define TASK_NOT_INDEPENDENT_EXCP "' can't run as a task, it has to follow the rules of the body of a '" PARALLEL_TK " " FORANGE_TK "': "
+#define TASK_READS_OUTER_EXCP "it reads a variable declared outside of the function: '"
+#define TASK_NEEDS_FUNC_EXCP "Tasks can only run functions declared with a name."
+#define TASK_FUNC_ARGS_EXCP "The function of a task has to be callable with this many arguments: "
+#define TASK_AWAIT_EXCP "Only the handle of a task, or a function without arguments, can be awaited."
+#define TASK_MAP_LIST_EXCP "The first argument of '" MAP_FN "' has to be a list."
+#define TASK_MAP_VOID_EXCP "The function given to '" MAP_FN "' has to return a value."
+#define VEC_LIST_ARG_EXCP "A function of '" VEC_MD "' needs an " INT_TP "[] or a " DOUBLE_TP "[] as argument "
+#define VEC_NUMBER_ARG_EXCP "A function of '" VEC_MD "' needs a number as argument "
+#define VEC_MAP_FUNC_EXCP "The second argument of '" VEC_MD "::" MAP_FN "' has to be a function of a native module that takes a " DOUBLE_TP " and returns a number."
+
 #endif //ODO_SEMANTICANALYZER_EN_H
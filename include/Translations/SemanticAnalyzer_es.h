@@ -9,6 +9,12 @@
 #define BOTH_BRANCH_SAME_TYPE_EXCP "Ambas ramas del operador ternario deben devolver el mismo tipo."
 #define BRANCHES_MUST_RETURN_EXCP "Las ramas del operador ternario deben ser expresiones validas. (Deben devolver un valor)"
 #define LST_EL_NO_VALUE_EXCP "El elemento en la lista no tiene o devuelve valor."
+#define MAP_EL_NO_VALUE_EXCP "La llave o el valor en el mapa no tiene o devuelve valor."
+#define MAP_KEY_TYPE_EXCP "Las llaves de un mapa solo pueden ser valores " INT_TP ", " DOUBLE_TP ", " STRING_TP " o " BOOL_TP ", no "
+#define MAP_KEYS_SAME_TYPE_EXCP "Todas las llaves de un mapa literal deben ser del mismo tipo."
+#define MAP_INDX_KEY_EXCP "Este mapa solo puede ser indexado con llaves de tipo "
+#define FOREACH_VALUE_ONLY_MAP_EXCP "Solo las entradas de un mapa tienen un valor para iterar junto a la llave."
+#define FOREACH_ONLY_FORWARD_EXCP "Las lineas de un archivo solo se pueden iterar desde el inicio."
 #define NOTHING_TO_ITERATE_EXCP "No hay nada sobre que iterar en la sentencia 'paracada'"
 #define INVALID_DECL_TYPE_EXCP "Declaracion invalida. Inicializando variable de tipo "
 #define WITH_VAL_OF_TYPE_EXCP " con un valor de tipo "
@@ -61,4 +67,27 @@
 #define SYM_IN_FUNC_DEF_EXCP "El simbolo en la definicion de tipo de funcion '"
 #define IS_NOT_TP_EXCP "' no es un tipo de valor."
 
+#define NOT_PARALLEL_EXCP "Las iteraciones de este '" PARALLEL_TK " " FORANGE_TK "' no son independientes: "
+#define PAR_ORDER_EXCP "contiene una sentencia que depende del orden de las iteraciones."
+#define PAR_ASSIGNS_OUTER_EXCP "asigna a una variable declarada fuera del ciclo: '"
+#define PAR_REDECLARES_ITER_EXCP "declara una nueva variable con el nombre del iterador '"
+#define PAR_LIST_INDEX_EXCP "cada uso de la lista '"
+#define PAR_BY_ITERATOR_EXCP "' debe estar indexado por el iterador del ciclo, en la misma posicion."
+#define PAR_LIST_IN_FUNC_EXCP "una funcion llamada en el ciclo lee la lista que este escribe: '"
+#define PAR_CALLS_EXCP "llama a '"
+#define PAR_SIDE_EFFECTS_EXCP "', que puede tener efectos secundarios."
+#define PAR_ON_OUTER_LIST_EXCP "' sobre una lista declarada fuera del ciclo."
+#define PAR_WRITES_MAP_EXCP "escribe en un mapa declarado fuera del ciclo: '"
+
+#define TASK_NOT_INDEPENDENT_EXCP "' no puede ejecutarse como tarea, debe seguir las reglas del cuerpo de un '" PARALLEL_TK " " FORANGE_TK "': "
+#define TASK_READS_OUTER_EXCP "lee una variable declarada fuera de la funcion: '"
+#define TASK_NEEDS_FUNC_EXCP "Las tareas solo pueden ejecutar funciones declaradas con un nombre."
+#define TASK_FUNC_ARGS_EXCP "La funcion de una tarea debe poder llamarse con esta cantidad de argumentos: "
+#define TASK_AWAIT_EXCP "Solo se puede esperar el manejador de una tarea, o una funcion sin argumentos."
+#define TASK_MAP_LIST_EXCP "El primer argumento de '" MAP_FN "' debe ser una lista."
+#define TASK_MAP_VOID_EXCP "La funcion pasada a '" MAP_FN "' debe retornar un valor."
+#define VEC_LIST_ARG_EXCP "Una funcion de '" VEC_MD "' necesita un " INT_TP "[] o un " DOUBLE_TP "[] como argumento "
+#define VEC_NUMBER_ARG_EXCP "Una funcion de '" VEC_MD "' necesita un numero como argumento "
+#define VEC_MAP_FUNC_EXCP "El segundo argumento de '" VEC_MD "::" MAP_FN "' debe ser una funcion de un modulo nativo que reciba un " DOUBLE_TP " y retorne un numero."
+
 #endif //ODO_SEMANTICANALYZER_ES_H
@@ -18,6 +18,7 @@
 #define FOR_TK "for"
 #define FOREACH_TK "foreach"
 #define FORANGE_TK "forange"
+#define PARALLEL_TK "parallel"
 #define WHILE_TK "while"
 #define LOOP_TK "loop"
 #define BREAK_TK "break"
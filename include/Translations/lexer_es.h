@@ -18,6 +18,7 @@
 #define FOR_TK "para"
 #define FOREACH_TK "paracada"
 #define FORANGE_TK "parango"
+#define PARALLEL_TK "paralelo"
 #define WHILE_TK "mientras"
 #define LOOP_TK "repetir"
 #define BREAK_TK "romper"
@@ -9,6 +9,7 @@
 
 #define VALUE_AT_MSG "<value> at: "
 #define FUNC_AT_MSG "<function> at: "
+#define FILE_AT_MSG "<file '"
 #define MODULE_AT_MSG "<module> at: "
 #define CLASS_AT_MSG "<class> at: "
 #define INSTANCE_AT_MSG "<instance> at: "
@@ -17,4 +18,29 @@
 #define CORRUPTED_MSG "<corrupted>"
 #define ANONYMUS_MSG "<anonymous>"
 
+// Heap profile
+#define HEAP_PROFILE_OFF_MSG "The heap profile is off. Run odo with --heap-profile to see it."
+#define HEAP_PROFILE_TITLE_MSG "Heap profile: "
+#define HEAP_PROFILE_VALUES_MSG " values, "
+#define HEAP_PROFILE_BYTES_MSG " bytes alive"
+#define HEAP_PROFILE_BY_TYPE_MSG "By type:"
+#define HEAP_PROFILE_BY_SITE_MSG "By site:"
+#define HEAP_PROFILE_BYTES_COL_MSG "bytes"
+#define HEAP_PROFILE_COUNT_COL_MSG "count"
+#define HEAP_PROFILE_IN_MSG " in "
+#define HEAP_PROFILE_NO_SITE_MSG "<interpreter>"
+
+#define NORMAL_KIND_MSG "normal"
+#define LIST_KIND_MSG "list"
+#define MAP_KIND_MSG "map"
+#define MATRIX_KIND_MSG "matrix"
+#define FILE_KIND_MSG "file"
+#define FUNCTION_KIND_MSG "function"
+#define MODULE_KIND_MSG "module"
+#define CLASS_KIND_MSG "class"
+#define INSTANCE_KIND_MSG "instance"
+#define ENUM_KIND_MSG "enum"
+#define ENUM_VAR_KIND_MSG "enum value"
+#define NATIVE_FUNCTION_KIND_MSG "native function"
+
 #endif //ODO_VALUE_EN_H
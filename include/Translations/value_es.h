@@ -10,6 +10,7 @@
 
 #define VALUE_AT_MSG "<valor> at: "
 #define FUNC_AT_MSG "<funcion> at: "
+#define FILE_AT_MSG "<archivo '"
 #define MODULE_AT_MSG "<modulo> at: "
 #define CLASS_AT_MSG "<clase> at: "
 #define INSTANCE_AT_MSG "<instancia> at: "
@@ -18,4 +19,29 @@
 #define CORRUPTED_MSG "<corrupto>"
 #define ANONYMUS_MSG "<anonimo>"
 
+// Heap profile
+#define HEAP_PROFILE_OFF_MSG "El perfil de memoria esta apagado. Ejecuta odo con --heap-profile para verlo."
+#define HEAP_PROFILE_TITLE_MSG "Perfil de memoria: "
+#define HEAP_PROFILE_VALUES_MSG " valores, "
+#define HEAP_PROFILE_BYTES_MSG " bytes vivos"
+#define HEAP_PROFILE_BY_TYPE_MSG "Por tipo:"
+#define HEAP_PROFILE_BY_SITE_MSG "Por sitio:"
+#define HEAP_PROFILE_BYTES_COL_MSG "bytes"
+#define HEAP_PROFILE_COUNT_COL_MSG "cantidad"
+#define HEAP_PROFILE_IN_MSG " en "
+#define HEAP_PROFILE_NO_SITE_MSG "<interprete>"
+
+#define NORMAL_KIND_MSG "normal"
+#define LIST_KIND_MSG "lista"
+#define MAP_KIND_MSG "mapa"
+#define MATRIX_KIND_MSG "matriz"
+#define FILE_KIND_MSG "archivo"
+#define FUNCTION_KIND_MSG "funcion"
+#define MODULE_KIND_MSG "modulo"
+#define CLASS_KIND_MSG "clase"
+#define INSTANCE_KIND_MSG "instancia"
+#define ENUM_KIND_MSG "enum"
+#define ENUM_VAR_KIND_MSG "valor de enum"
+#define NATIVE_FUNCTION_KIND_MSG "funcion nativa"
+
 #endif //ODO_VALUE_ES_H
@@ -9,8 +9,6 @@
 #include "Lexer/token.hpp"
 
 namespace Odo {
-    extern std::default_random_engine generator;
-
     bool contains_type(std::vector<Lexing::TokenType> arr, Lexing::TokenType t);
     bool ends_with(std::string const &, std::string const &);
     bool starts_with(std::string const &, std::string const &);
@@ -5,9 +5,56 @@
 #include "IO/io.h"
 #include <fstream>
 #include <filesystem>
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <new>
+#include <unordered_map>
 #include <Exceptions/exception.h>
 
+#if defined(_WIN32)
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace Odo::io {
+    namespace {
+        bool line_buffered = true;
+
+#if defined(_WIN32)
+        int sys_open(const char* path, int flags) { return _open(path, flags | _O_BINARY, 0644); }
+        long long sys_read(int fd, char* data, size_t size) { return _read(fd, data, (unsigned int)std::min<size_t>(size, 1 << 30)); }
+        long long sys_write(int fd, const char* data, size_t size) { return _write(fd, data, (unsigned int)std::min<size_t>(size, 1 << 30)); }
+        void sys_close(int fd) { _close(fd); }
+#else
+        int sys_open(const char* path, int flags) { return ::open(path, flags, 0644); }
+        long long sys_read(int fd, char* data, size_t size) { return ::read(fd, data, size); }
+        long long sys_write(int fd, const char* data, size_t size) { return ::write(fd, data, size); }
+        void sys_close(int fd) { ::close(fd); }
+#endif
+
+        // The mappings that are alive, by the absolute path of their file.
+        std::mutex mappings_mutex;
+        std::unordered_map<std::string, std::vector<std::weak_ptr<MappedFile>>> mappings;
+
+        std::string mapping_key(const std::string& path) {
+            std::error_code error;
+            auto canonical = std::filesystem::weakly_canonical(path, error);
+            return error ? path : canonical.string();
+        }
+    }
+
     std::string read_file(const std::string& path) {
         std::ifstream argumentFile(path);
         if (argumentFile.fail()) {
@@ -22,6 +69,124 @@ namespace Odo::io {
         return contents;
     }
 
+    std::shared_ptr<MappedFile> MappedFile::create(const std::string& path) {
+        std::shared_ptr<MappedFile> file(new MappedFile(path));
+
+        std::lock_guard<std::mutex> lock(mappings_mutex);
+        auto& same_file = mappings[mapping_key(path)];
+        std::erase_if(same_file, [](const std::weak_ptr<MappedFile>& other) { return other.expired(); });
+        same_file.push_back(file);
+
+        return file;
+    }
+
+    void MappedFile::release(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mappings_mutex);
+        auto found = mappings.find(mapping_key(path));
+        if (found == mappings.end()) return;
+
+        for (auto& weak : found->second) {
+            if (auto file = weak.lock()) {
+                file->copy_into_memory();
+            }
+        }
+        mappings.erase(found);
+    }
+
+#if defined(_WIN32)
+    MappedFile::MappedFile(const std::string& path)
+        : contents(read_file(path))
+    {
+        data = contents.data();
+        size = contents.size();
+    }
+
+    MappedFile::~MappedFile() = default;
+
+    // The contents were read into memory already.
+    void MappedFile::copy_into_memory() {
+        mapped = false;
+    }
+#else
+    MappedFile::MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw Exceptions::IOException(path);
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw Exceptions::IOException(path);
+        }
+
+        size = (size_t)info.st_size;
+        // mmap can't map nothing, and an empty view needs no memory.
+        if (size > 0) {
+            auto mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw Exceptions::IOException(path);
+            }
+
+            // The whole file is usually read from start to end.
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapped);
+        }
+
+        // The mapping stays valid after the file is closed.
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (data) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    void MappedFile::copy_into_memory() {
+        if (!mapped || !data) {
+            mapped = false;
+            return;
+        }
+
+        auto target = const_cast<char*>(data);
+        auto copy = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (copy == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        std::memcpy(copy, data, size);
+
+#if defined(__linux__)
+        // Moves the copy over the mapping in one step, so a thread reading it never sees the pages change.
+        mprotect(copy, size, PROT_READ);
+        if (mremap(copy, size, size, MREMAP_MAYMOVE | MREMAP_FIXED, target) == MAP_FAILED) {
+            munmap(copy, size);
+            throw std::bad_alloc();
+        }
+#else
+        // Puts memory of its own where the mapping was, and fills it back in.
+        if (mmap(target, size, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED) {
+            munmap(copy, size);
+            throw std::bad_alloc();
+        }
+        std::memcpy(target, copy, size);
+        mprotect(target, size, PROT_READ);
+        munmap(copy, size);
+#endif
+
+        mapped = false;
+    }
+#endif
+
+    size_t file_size(const std::string& path) {
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(path, error)) return 0;
+
+        auto size = std::filesystem::file_size(path, error);
+        return error ? 0 : (size_t)size;
+    }
+
     std::string get_file_name(const std::string& path, bool ignore_extension) {
         std::size_t found = path.find_last_of(std::filesystem::path::preferred_separator);
         std::string result = path.substr(found+1);
@@ -69,10 +234,12 @@ namespace Odo::io {
     }
 
     void create_file(const std::string& path) {
+        MappedFile::release(path);
         std::ofstream result(path);
     }
 
     void write_to_file(const std::string &path, const std::string &content) {
+        MappedFile::release(path);
         std::ofstream result(path);
         if (result.is_open()) {
             result << content;
@@ -96,4 +263,234 @@ namespace Odo::io {
 
         result.close();
     }
-}
\ No newline at end of file
+
+    void buffer_stdout() {
+        std::ios::sync_with_stdio(false);
+        line_buffered = isatty(fileno(stdout));
+    }
+
+    void end_line() {
+        std::cout << '\n';
+        if (line_buffered) {
+            std::cout.flush();
+        }
+    }
+
+    bool Input::fill() {
+        if (start > 0) {
+            std::memmove(buffer.data(), buffer.data() + start, end - start);
+            end -= start;
+            start = 0;
+        }
+        if (end == buffer.size()) return false;
+
+        std::cout.flush();
+        while (true) {
+            auto got = sys_read(0, buffer.data() + end, buffer.size() - end);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+
+            end += (size_t)got;
+            return true;
+        }
+    }
+
+    bool Input::skip_whitespace() {
+        while (true) {
+            while (start < end && std::isspace((unsigned char)buffer[start])) start++;
+            if (start < end) return true;
+            if (!fill()) return false;
+        }
+    }
+
+    std::string_view Input::next_word() {
+        if (!skip_whitespace()) return {};
+
+        size_t length = 0;
+        while (true) {
+            while (start + length < end && !std::isspace((unsigned char)buffer[start + length])) length++;
+            if (start + length < end || !fill()) break;
+        }
+
+        return {buffer.data() + start, length};
+    }
+
+    bool Input::read_int(int& value) {
+        auto word = next_word();
+        auto first = word.data();
+        // std::from_chars doesn't take a plus sign, but >> does.
+        if (!word.empty() && word[0] == '+') first++;
+
+        auto result = std::from_chars(first, word.data() + word.size(), value);
+        if (result.ec != std::errc() || result.ptr == first) return false;
+
+        start += (size_t)(result.ptr - word.data());
+        return true;
+    }
+
+    bool Input::read_double(double& value) {
+        auto word = next_word();
+        auto first = word.data();
+        if (!word.empty() && word[0] == '+') first++;
+
+        auto result = std::from_chars(first, word.data() + word.size(), value);
+        if (result.ec != std::errc() || result.ptr == first) return false;
+
+        start += (size_t)(result.ptr - word.data());
+        return true;
+    }
+
+    bool Input::read_line(std::string& line) {
+        line.clear();
+        bool read_any = false;
+        while (start < end || fill()) {
+            read_any = true;
+            auto from = buffer.data() + start;
+            auto newline = static_cast<const char*>(std::memchr(from, '\n', end - start));
+            if (newline) {
+                line.append(from, (size_t)(newline - from));
+                start += (size_t)(newline - from) + 1;
+                return true;
+            }
+
+            line.append(from, end - start);
+            start = end;
+        }
+
+        return read_any;
+    }
+
+    int Input::get() {
+        if (start == end && !fill()) return -1;
+        return (unsigned char)buffer[start++];
+    }
+
+    void Input::ignore() {
+        get();
+    }
+
+    Input& standard_input() {
+        static Input input;
+        return input;
+    }
+
+    File::File(const std::string& path, Mode mode, size_t buffer_size)
+        : file_mode(mode)
+        , file_path(path)
+        , buffer(buffer_size)
+    {
+        int flags = 0;
+        switch (mode) {
+            case Mode::Read: flags |= O_RDONLY; break;
+            case Mode::Write:
+                flags |= O_WRONLY | O_CREAT | O_TRUNC;
+                MappedFile::release(path);
+                break;
+            case Mode::Append: flags |= O_WRONLY | O_CREAT | O_APPEND; break;
+        }
+
+        fd = sys_open(path.c_str(), flags);
+        if (fd < 0) {
+            throw Exceptions::IOException(path);
+        }
+    }
+
+    File::~File() {
+        try {
+            close();
+        } catch (Exceptions::IOException&) {
+            // Nothing can be reported from here.
+        }
+    }
+
+    void File::write_all(const char* data, size_t size) {
+        while (size > 0) {
+            auto written = sys_write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw Exceptions::IOException(file_path);
+            }
+
+            data += written;
+            size -= (size_t)written;
+        }
+    }
+
+    void File::write(std::string_view text) {
+        if (end + text.size() > buffer.size()) {
+            flush();
+        }
+
+        if (text.size() >= buffer.size()) {
+            write_all(text.data(), text.size());
+            return;
+        }
+
+        std::memcpy(buffer.data() + end, text.data(), text.size());
+        end += text.size();
+    }
+
+    void File::flush() {
+        if (file_mode == Mode::Read || end == 0) return;
+
+        auto pending = end;
+        end = 0;
+        write_all(buffer.data(), pending);
+    }
+
+    bool File::fill() {
+        start = 0;
+        end = 0;
+        while (true) {
+            auto got = sys_read(fd, buffer.data(), buffer.size());
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                throw Exceptions::IOException(file_path);
+            }
+
+            end = (size_t)got;
+            return got > 0;
+        }
+    }
+
+    bool File::read_line(std::string& line) {
+        line.clear();
+        bool read_any = false;
+        while (start < end || fill()) {
+            read_any = true;
+            auto from = buffer.data() + start;
+            auto newline = static_cast<const char*>(std::memchr(from, '\n', end - start));
+            if (newline) {
+                line.append(from, (size_t)(newline - from));
+                start += (size_t)(newline - from) + 1;
+                return true;
+            }
+
+            line.append(from, end - start);
+            start = end;
+        }
+
+        return read_any;
+    }
+
+    bool File::at_end() {
+        return start >= end && !fill();
+    }
+
+    void File::close() {
+        if (fd < 0) return;
+
+        // The file is closed even if the last write fails.
+        auto closing = fd;
+        try {
+            flush();
+        } catch (Exceptions::IOException&) {
+            fd = -1;
+            sys_close(closing);
+            throw;
+        }
+
+        fd = -1;
+        sys_close(closing);
+    }
+}
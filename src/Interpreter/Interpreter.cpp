@@ -23,6 +23,8 @@
 #include "Parser/AST/VariableNode.h"
 #include "Parser/AST/AssignmentNode.h"
 #include "Parser/AST/ListExpressionNode.h"
+#include "Parser/AST/MapExpressionNode.h"
+#include "Parser/AST/MapTypeNode.h"
 #include "Parser/AST/BlockNode.h"
 #include "Parser/AST/FuncExpressionNode.h"
 #include "Parser/AST/FuncDeclNode.h"
@@ -44,17 +46,20 @@
 #include "Parser/AST/InstanceBodyNode.h"
 #include "Parser/AST/ClassInitializerNode.h"
 #include "Parser/AST/ConstructorDeclNode.h"
-#include "Parser/AST/ConstructorCallNode.h"
 #include "Parser/AST/StaticStatementNode.h"
 #include "Parser/AST/MemberVarNode.h"
 #include "Parser/AST/StaticVarNode.h"
 #include "Parser/AST/IndexNode.h"
 
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <utility>
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 #define noop (void)0
@@ -63,47 +68,218 @@
 namespace Odo::Interpreting {
     using namespace Parsing;
 
-    Interpreter::Interpreter(Parser p): parser(std::move(p)) {
-        auto any_symbol = Symbol{.name=ANY_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+    SymbolTable& Interpreter::primitive_types() {
+        // Built once, the first time any interpreter is created, and never written to after that.
+        static const std::unique_ptr<SymbolTable> types = [] {
+            auto any_symbol = Symbol{.name=ANY_TP, .isType=true, .kind=SymbolType::PrimitiveType};
 
-        std::unordered_map<std::string, Symbol> buildInTypes {
-            {ANY_TP, any_symbol}
-        };
-        globalTable = SymbolTable("global", buildInTypes);
+            std::unordered_map<std::string, Symbol> buildInTypes {
+                {ANY_TP, any_symbol}
+            };
+            auto table = std::make_unique<SymbolTable>("primitives", buildInTypes);
+
+            auto any_sym = &table->symbols[ANY_TP];
 
-        auto any_sym = &globalTable.symbols[ANY_TP];
+            table->symbols[INT_TP] = {.tp=any_sym, .name=INT_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+            table->symbols[DOUBLE_TP] = {.tp=any_sym, .name=DOUBLE_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+            table->symbols[STRING_TP] = {.tp=any_sym, .name=STRING_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+            table->symbols[BOOL_TP] = {.tp=any_sym, .name=BOOL_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+            table->symbols[POINTER_TP] = {.tp=any_sym, .name=POINTER_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+            table->symbols[NULL_TP] = {.tp=any_sym, .name=NULL_TP, .isType=true, .kind=SymbolType::PrimitiveType};
 
-        globalTable.symbols[INT_TP] = {.tp=any_sym, .name=INT_TP, .isType=true, .kind=SymbolType::PrimitiveType};
-        globalTable.symbols[DOUBLE_TP] = {.tp=any_sym, .name=DOUBLE_TP, .isType=true, .kind=SymbolType::PrimitiveType};
-        globalTable.symbols[STRING_TP] = {.tp=any_sym, .name=STRING_TP, .isType=true, .kind=SymbolType::PrimitiveType};
-        globalTable.symbols[BOOL_TP] = {.tp=any_sym, .name=BOOL_TP, .isType=true, .kind=SymbolType::PrimitiveType};
-        globalTable.symbols[POINTER_TP] = {.tp=any_sym, .name=POINTER_TP, .isType=true, .kind=SymbolType::PrimitiveType};
-        globalTable.symbols[NULL_TP] = {.tp=any_sym, .name=NULL_TP, .isType=true, .kind=SymbolType::PrimitiveType};
+            return table;
+        }();
+
+        return *types;
+    }
+
+    Interpreter::Interpreter(Parser p): parser(std::move(p)) {
+        auto& primitives = primitive_types();
+        heap = std::make_shared<Heap>();
+        globalTable = std::make_shared<SymbolTable>("global", std::unordered_map<std::string, Symbol>{}, &primitives);
 
-        int_type = &globalTable.symbols[INT_TP];
-        double_type = &globalTable.symbols[DOUBLE_TP];
-        string_type = &globalTable.symbols[STRING_TP];
-        bool_type = &globalTable.symbols[BOOL_TP];
+        int_type = primitives.findSymbol(INT_TP);
+        double_type = primitives.findSymbol(DOUBLE_TP);
+        string_type = primitives.findSymbol(STRING_TP);
+        bool_type = primitives.findSymbol(BOOL_TP);
 
-        currentScope = &globalTable;
+        currentScope = globalTable.get();
 
-        replScope = SymbolTable("repl", {}, &globalTable);
+        replScope = SymbolTable("repl", {}, globalTable.get());
 
-        null = NormalValue::create(globalTable.findSymbol(NULL_TP), NULL_TK);
+        null = NormalValue::create(globalTable->findSymbol(NULL_TP), NULL_TK);
 
-        globalTable.addSymbol({
-            .tp = &globalTable.symbols[NULL_TP],
+        globalTable->addSymbol({
+            .tp = globalTable->findSymbol(NULL_TP),
             .name = NULL_TK,
             .value = null
         });
 
-        replScope.symbols["_"] = {.tp=any_sym, .name="_", .value=null, .isType=false, .kind=SymbolType::VarSymbol};
+        replScope.symbols["_"] = {.tp=any_type(), .name="_", .value=null, .isType=false, .kind=SymbolType::VarSymbol};
 
         returning = nullptr;
         returning_native = nullptr;
 
         analyzer = std::make_shared<Semantics::SemanticAnalyzer>(*this);
 
+        register_native_functions();
+
+        add_function(CLEAR_FN, {}, nullptr, [](auto){std::cout << "\033[2J\033[1;1H"; return 0;});
+        add_function(WAIT_FN, {}, nullptr,[](auto){ io::standard_input().get(); return 0; });
+        add_function(FLUSH_FN, {}, nullptr, [](auto){ std::cout.flush(); return 0; });
+
+        add_function(SLEEP_FN, {{int_type, false}}, nullptr, [](auto vals){
+            // Whatever was printed before the pause should be seen during it.
+            std::cout.flush();
+            auto delay_time = std::any_cast<int>(vals[0]);
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_time));
+
+            return 0;
+        });
+
+        // Collects nothing while tasks or the iterations of a parallel forange are running.
+        add_function(GC_COLLECT_FN, {}, int_type, [this](auto){
+            return static_cast<int>(heap->collect(true));
+        });
+
+        auto stats_type = globalTable->addMapType(string_type, int_type);
+        add_function(HEAP_STATS_FN, {}, stats_type, [this, stats_type](const std::vector<value_t>&) -> value_t {
+            auto stats = heap->stats();
+            auto result = MapValue::create(stats_type);
+            auto add = [&](const std::string& key, size_t value) {
+                result->set(create_literal(key), create_literal(static_cast<int>(value)));
+            };
+
+            add(HEAP_LISTS_KEY, stats.live[ValueType::ListVal]);
+            add(HEAP_MAPS_KEY, stats.live[ValueType::MapVal]);
+            add(HEAP_INSTANCES_KEY, stats.live[ValueType::InstanceVal]);
+            add(HEAP_CLASSES_KEY, stats.live[ValueType::ClassVal]);
+            add(HEAP_COLLECTIONS_KEY, stats.collections);
+            add(HEAP_FULL_COLLECTIONS_KEY, stats.full_collections);
+            add(HEAP_RECLAIMED_OBJECTS_KEY, stats.reclaimed_objects);
+            add(HEAP_RECLAIMED_BYTES_KEY, stats.reclaimed_bytes);
+            return result;
+        });
+
+        // Goes to stderr, so it doesn't get mixed with what the program writes.
+        // Writes nothing while tasks or the iterations of a parallel forange are running, since they could be changing the values.
+        add_function(HEAP_SNAPSHOT_FN, {}, nullptr, [this](auto){
+            heap->run_alone([] {
+                std::cout.flush();
+                HeapProfile::report(std::cerr);
+            });
+            return 0;
+        });
+    }
+
+    Interpreter::Interpreter(Interpreter& parent, SymbolTable* scope) {
+        analyzer = parent.analyzer;
+        heap = parent.heap;
+        globalTable = parent.globalTable;
+        currentScope = scope;
+        null = parent.null;
+
+        int_type = parent.int_type;
+        double_type = parent.double_type;
+        string_type = parent.string_type;
+        bool_type = parent.bool_type;
+
+        // Keeps the depth limit of function calls the same as on the parent.
+        call_stack = parent.call_stack;
+        current_line = parent.current_line;
+        current_col = parent.current_col;
+
+        returning = nullptr;
+        returning_native = nullptr;
+        is_worker = true;
+
+        // The natives keep a reference to the interpreter that registered them.
+        register_native_functions();
+    }
+
+    namespace {
+        // What the values of a list can be compared by, without a comparison function.
+        enum class sort_key { Int, Double, String, None };
+
+        sort_key sort_key_of(const std::vector<Symbol>& elements) {
+            bool all_int = true;
+            bool all_numeric = true;
+            bool all_string = true;
+            for (const auto& element : elements) {
+                auto& name = element.value->type->name;
+                all_int = all_int && name == INT_TP;
+                all_numeric = all_numeric && (name == INT_TP || name == DOUBLE_TP);
+                all_string = all_string && name == STRING_TP;
+            }
+
+            if (all_int) return sort_key::Int;
+            if (all_numeric) return sort_key::Double;
+            if (all_string) return sort_key::String;
+            return sort_key::None;
+        }
+
+        int read_int(const value_t& v) { return Value::as<NormalValue>(v)->as_int(); }
+
+        double read_number(const value_t& v) {
+            auto as_normal = Value::as<NormalValue>(v);
+            return v->type->name == INT_TP ? as_normal->as_int() : as_normal->as_double();
+        }
+
+        std::string_view read_string(const value_t& v) { return Value::as<NormalValue>(v)->as_string_view(); }
+
+        bool int_before(int a, int b) { return a < b; }
+
+        // NaN goes after every other number, so the order stays strict and std::sort stays in bounds.
+        bool number_before(double a, double b) { return a < b || (std::isnan(b) && !std::isnan(a)); }
+
+        bool string_before(std::string_view a, std::string_view b) { return a < b; }
+
+        // The keys are read once into a flat vector, so comparing doesn't go through the values again.
+        // The string views stay valid because keyed holds their values.
+        template<typename Key, typename Read, typename Before>
+        void sort_by_key(std::vector<Symbol>& elements, Read read, Before before) {
+            std::vector<std::pair<Key, value_t>> keyed;
+            keyed.reserve(elements.size());
+            for (auto& element : elements) {
+                keyed.emplace_back(read(element.value), std::move(element.value));
+            }
+
+            std::sort(keyed.begin(), keyed.end(), [&](const auto& a, const auto& b) {
+                return before(a.first, b.first);
+            });
+
+            for (size_t i = 0; i < elements.size(); i++) {
+                elements[i].value = std::move(keyed[i].second);
+                elements[i].tp = elements[i].value->type;
+            }
+        }
+
+        // The position of the first element that doesn't go before value.
+        template<typename Key, typename Read, typename Before>
+        size_t lower_bound_by_key(const std::vector<Symbol>& elements, const value_t& value, Read read, Before before) {
+            auto key = read(value);
+            auto found = std::lower_bound(elements.begin(), elements.end(), key, [&](const Symbol& element, const Key& k) {
+                return before(read(element.value), k);
+            });
+
+            return found - elements.begin();
+        }
+    }
+
+    bool Interpreter::comes_before(RepeatedCall& cmp, const value_t& a, const value_t& b) {
+        auto result = cmp({a, b});
+        if (result->type->name != BOOL_TP) {
+            throw Exceptions::FunctionCallException(
+                CMP_MUST_RETURN_BOOL_EXCP,
+                current_line,
+                current_col
+            );
+        }
+
+        return Value::as<NormalValue>(result)->as_bool();
+    }
+
+    void Interpreter::register_native_functions() {
 #ifdef DEBUG_FUNCTIONS
         add_native_function("valueAt", [&](auto values) {
             int a = values[0]->as_int();
@@ -113,21 +289,21 @@ namespace Odo::Interpreting {
 #endif
 
         add_native_function(WRITE_FN, [&](auto values) {
+            Sink out(std::cout);
             for (const auto& v : values) {
                 if (v)
-                    std::cout << v->to_string();
+                    v->render(out);
             }
-            // Might make printing slower... I don't know of a better way of doing this.
-            std::cout.flush();
             return null;
         });
 
         add_native_function(WRITELN_FN, [&](auto values) {
+            Sink out(std::cout);
             for (const auto& v : values) {
                 if (v)
-                    std::cout << v->to_string();
+                    v->render(out);
             }
-            std::cout << std::endl;
+            io::end_line();
             return null;
         });
 
@@ -162,10 +338,13 @@ namespace Odo::Interpreting {
             if (!v.empty()) {
                 auto arg = v[0];
                 if (arg->type->name == STRING_TP) {
-                    size_t len = Value::as<NormalValue>(arg)->as_string().size();
+                    size_t len = Value::as<NormalValue>(arg)->as_string_view().size();
                     return create_literal((int)len);
                 } else if (arg->kind() == ValueType::ListVal) {
-                    size_t len = Value::as<ListValue>(arg)->as_list_value().size();
+                    size_t len = Value::as<ListValue>(arg)->elements.size();
+                    return create_literal((int)len);
+                } else if (arg->kind() == ValueType::MapVal) {
+                    size_t len = Value::as<MapValue>(arg)->entries.size();
                     return create_literal((int)len);
                 }
             }
@@ -180,7 +359,7 @@ namespace Odo::Interpreting {
             if (!vals.empty()) {
                 int val = Value::as<NormalValue>(vals[0])->as_int();
 
-                return create_literal(std::string(1, val));
+                return create_char_literal(static_cast<char>(val));
             }
 
             return null;
@@ -188,7 +367,8 @@ namespace Odo::Interpreting {
 
         add_native_function(TO_ASCII_FN, [&](std::vector<value_t> vals) {
             if (!vals.empty()) {
-                char val = Value::as<NormalValue>(vals[0])->as_string()[0];
+                auto str = Value::as<NormalValue>(vals[0])->as_string_view();
+                char val = str.empty() ? '\0' : str[0];
 
                 return create_literal(static_cast<int>(val));
             }
@@ -353,34 +533,64 @@ namespace Odo::Interpreting {
 
         add_native_function(READ_FN, [&](const std::vector<value_t>& vals) {
             std::string result;
+            Sink out(std::cout);
             for (const auto& v : vals) {
-                std::cout << v->to_string();
+                v->render(out);
             }
 
-            std::getline(std::cin, result);
+            io::standard_input().read_line(result);
             return create_literal(result);
         });
 
         add_native_function(READ_INT_FN, [&](const std::vector<value_t>& vals) {
-            int result;
+            int result = 0;
+            Sink out(std::cout);
             for (const auto& v : vals) {
-                std::cout << v->to_string();
+                v->render(out);
             }
-            std::cin >> result;
-            std::cin.ignore();
+
+            auto& input = io::standard_input();
+            input.read_int(result);
+            input.ignore();
             return create_literal(result);
         });
 
         add_native_function(READ_DOUBLE_FN, [&](const std::vector<value_t>& vals) {
-            double result;
+            double result = 0;
+            Sink out(std::cout);
             for (const auto& v : vals) {
-                std::cout << v->to_string();
+                v->render(out);
             }
-            std::cin >> result;
-            std::cin.ignore();
+
+            auto& input = io::standard_input();
+            input.read_double(result);
+            input.ignore();
             return create_literal(result);
         });
 
+        // Read the rest of stdin in a single call.
+        add_native_function(READ_ALL_INTS_FN, [&](const std::vector<value_t>&) {
+            auto& input = io::standard_input();
+            std::vector<Symbol> elements;
+            int value;
+            while (input.read_int(value)) {
+                elements.push_back({int_type, "list_element", NormalValue::create(int_type, value)});
+            }
+
+            return (value_t)ListValue::create(globalTable->addListType(int_type), std::move(elements));
+        });
+
+        add_native_function(READ_LINES_FN, [&](const std::vector<value_t>&) {
+            auto& input = io::standard_input();
+            std::vector<Symbol> elements;
+            std::string line;
+            while (input.read_line(line)) {
+                elements.push_back({string_type, "list_element", NormalValue::create(string_type, line)});
+            }
+
+            return (value_t)ListValue::create(globalTable->addListType(string_type), std::move(elements));
+        });
+
         add_native_function(RAND_FN, [&](std::vector<value_t> vals) {
             double min = 0.0;
             double max = 1.0;
@@ -460,29 +670,122 @@ namespace Odo::Interpreting {
             return null;
         });
 
-        add_native_function(TYPEOF_FN, [&](const auto& vals) {
-            if (vals.size() == 1) {
-                auto v = vals[0];
-                if (v) return create_literal(v->type->name);
+        add_native_function(SORT_FN, [&](std::vector<value_t> vals) {
+            if (vals.empty() || vals.size() > 2 || vals[0]->kind() != ValueType::ListVal
+                || (vals.size() == 2 && vals[1]->kind() != ValueType::FunctionVal)) {
+                throw Exceptions::FunctionCallException(SORT_REQ_ARGS_EXCP, current_line, current_col);
+            }
+
+            auto& elements = Value::as<ListValue>(vals[0])->elements;
+
+            if (vals.size() == 2) {
+                // Sorted apart from the list, so it's left as it was if the comparison fails.
+                // A merge sort stays in bounds even if the comparison isn't consistent.
+                RepeatedCall cmp(*this, Value::as<FunctionValue>(vals[1]));
+                std::vector<value_t> sorted;
+                sorted.reserve(elements.size());
+                for (const auto& element : elements) {
+                    sorted.push_back(element.value);
+                }
+
+                std::stable_sort(sorted.begin(), sorted.end(), [&](const value_t& a, const value_t& b) {
+                    return comes_before(cmp, a, b);
+                });
+
+                for (size_t i = 0; i < elements.size(); i++) {
+                    elements[i].value = std::move(sorted[i]);
+                    elements[i].tp = elements[i].value->type;
+                }
+                return null;
+            }
+
+            switch (sort_key_of(elements)) {
+                case sort_key::Int:
+                    sort_by_key<int>(elements, read_int, int_before);
+                    break;
+                case sort_key::Double:
+                    sort_by_key<double>(elements, read_number, number_before);
+                    break;
+                case sort_key::String:
+                    sort_by_key<std::string_view>(elements, read_string, string_before);
+                    break;
+                case sort_key::None:
+                    throw Exceptions::FunctionCallException(NOT_COMPARABLE_EXCP, current_line, current_col);
             }
 
             return null;
         });
 
-        add_function(CLEAR_FN, {}, nullptr, [](auto){std::cout << "\033[2J\033[1;1H"; return 0;});
-        add_function(WAIT_FN, {}, nullptr,[](auto){ std::cin.get(); return 0; });
+        add_native_function(BINARY_SEARCH_FN, [&](std::vector<value_t> vals) {
+            if (vals.size() < 2 || vals.size() > 3 || vals[0]->kind() != ValueType::ListVal
+                || (vals.size() == 3 && vals[2]->kind() != ValueType::FunctionVal)) {
+                throw Exceptions::FunctionCallException(BIN_SEARCH_REQ_ARGS_EXCP, current_line, current_col);
+            }
 
-        add_function(SLEEP_FN, {{&globalTable.symbols.at(INT_TP), false}}, nullptr, [](auto vals){
-            auto delay_time = std::any_cast<int>(vals[0]);
-            std::this_thread::sleep_for(std::chrono::milliseconds(delay_time));
+            auto& elements = Value::as<ListValue>(vals[0])->elements;
+            auto& value = vals[1];
 
-            return 0;
+            size_t position;
+            bool found;
+            if (vals.size() == 3) {
+                RepeatedCall cmp(*this, Value::as<FunctionValue>(vals[2]));
+                auto first = std::lower_bound(elements.begin(), elements.end(), value, [&](const Symbol& element, const value_t& v) {
+                    return comes_before(cmp, element.value, v);
+                });
+
+                position = first - elements.begin();
+                found = position < elements.size() && !comes_before(cmp, value, elements[position].value);
+            } else {
+                auto& name = value->type->name;
+                auto list_key = sort_key_of(elements);
+                bool is_number = name == INT_TP || name == DOUBLE_TP;
+
+                if (list_key == sort_key::String && name == STRING_TP) {
+                    position = lower_bound_by_key<std::string_view>(elements, value, read_string, string_before);
+                    found = position < elements.size() && read_string(elements[position].value) == read_string(value);
+                } else if ((list_key == sort_key::Int || list_key == sort_key::Double) && is_number) {
+                    position = lower_bound_by_key<double>(elements, value, read_number, number_before);
+                    found = position < elements.size() && !number_before(read_number(value), read_number(elements[position].value));
+                } else if (elements.empty() && (is_number || name == STRING_TP)) {
+                    position = 0;
+                    found = false;
+                } else {
+                    throw Exceptions::FunctionCallException(NOT_COMPARABLE_EXCP, current_line, current_col);
+                }
+            }
+
+            return create_literal(found ? (int) position : -1);
+        });
+
+        add_native_function(REVERSE_FN, [&](std::vector<value_t> vals) {
+            if (vals.size() != 1 || vals[0]->kind() != ValueType::ListVal) {
+                throw Exceptions::FunctionCallException(REVERSE_REQ_LIST_EXCP, current_line, current_col);
+            }
+
+            auto& elements = Value::as<ListValue>(vals[0])->elements;
+            std::reverse(elements.begin(), elements.end());
+            return null;
+        });
+
+        add_native_function(TYPEOF_FN, [&](const auto& vals) {
+            if (vals.size() == 1) {
+                auto v = vals[0];
+                if (v) return create_literal(v->type->name);
+            }
+
+            return null;
         });
 
         add_native_function(READ_FILE_FN, [&](const auto& vals){
             if (!vals.empty()) {
                 auto path = Value::as<NormalValue>(vals[0])->as_string();
                 try {
+                    // Big files are mapped, so only the parts that are read get loaded.
+                    if (io::file_size(path) >= io::map_threshold) {
+                        mapped_text contents = io::MappedFile::create(path);
+                        return (value_t)NormalValue::create(string_type, contents);
+                    }
+
                     auto contents = io::read_file(path);
                     return create_literal(contents);
                 } catch (Exceptions::IOException&) {
@@ -542,7 +845,7 @@ namespace Odo::Interpreting {
                     });
                 }
 
-                value_t list_value = ListValue::create(globalTable.findSymbol(STRING_TP), std::move(lst_syms));
+                value_t list_value = ListValue::create(globalTable->findSymbol(STRING_TP), std::move(lst_syms));
                 return list_value;
             }
             return null;
@@ -584,7 +887,7 @@ namespace Odo::Interpreting {
     }
 
     Symbol* Interpreter::any_type() {
-        return &globalTable.symbols[ANY_TP];
+        return globalTable->findSymbol(ANY_TP);
     }
 
     void Interpreter::add_function(
@@ -593,9 +896,9 @@ namespace Odo::Interpreting {
         Symbol* ret,
         const std::function<std::any(std::vector<std::any>)>& callback
     ) {
-        auto function_type = globalTable.addFuncType(ret, args);
+        auto function_type = globalTable->addFuncType(ret, args);
 
-        auto function_symbol = globalTable.addSymbol({
+        auto function_symbol = globalTable->addSymbol({
             .tp=function_type,
             .name=name,
             .kind=Interpreting::SymbolType::FunctionSymbol
@@ -615,9 +918,9 @@ namespace Odo::Interpreting {
             const std::function<value_t(
                     std::vector<value_t>)> &callback
     ) {
-        auto function_type = globalTable.addFuncType(ret, args);
+        auto function_type = globalTable->addFuncType(ret, args);
 
-        auto function_symbol = globalTable.addSymbol({
+        auto function_symbol = globalTable->addSymbol({
             .tp=function_type,
             .name=name,
             .kind=Interpreting::SymbolType::FunctionSymbol
@@ -718,6 +1021,8 @@ namespace Odo::Interpreting {
 
             case NodeType::ListExpression:
                 return visit_ListExpression(Node::as<ListExpressionNode>(node));
+            case NodeType::MapExpression:
+                return visit_MapExpression(Node::as<MapExpressionNode>(node));
 
             // Functions
             case NodeType::FuncExpression:
@@ -742,8 +1047,6 @@ namespace Odo::Interpreting {
 //          Broken or incomplete.
             case NodeType::ConstructorDecl:
                 return visit_ConstructorDecl(Node::as<ConstructorDeclNode>(node));
-            case NodeType::ConstructorCall:
-                return visit_ConstructorCall(Node::as<ConstructorCallNode>(node));
             case NodeType::InstanceBody:
                 return visit_InstanceBody(Node::as<InstanceBodyNode>(node));
             case NodeType::ClassInitializer:
@@ -769,6 +1072,10 @@ namespace Odo::Interpreting {
 
             case NodeType::Debug:
                 noop;
+            // Map types are only read as types, through getSymbolFromNode.
+            case NodeType::MapType:
+            // Constructors are called by the initializer of the class, straight from its layout.
+            case NodeType::ConstructorCall:
             case NodeType::Null:
                 return null;
         }
@@ -810,6 +1117,7 @@ namespace Odo::Interpreting {
             int a = (int) strtol(val.c_str(), nullptr, 10);
             return create_literal(a);
         } else if (kind == STRING_TP) {
+            if (val.size() == 1) return create_char_literal(val[0]);
             return create_literal(val);
         } else if (kind == BOOL_TP) {
             if (val != TRUE_TK && val != FALSE_TK){
@@ -831,6 +1139,21 @@ namespace Odo::Interpreting {
         return NormalValue::create(string_type, val);
     }
 
+    value_t Interpreter::create_char_literal(char val) {
+        // Nothing changes a value in place while anything else holds it, so one value per character
+        // can be handed out to every interpreter. Character by character loops then don't allocate.
+        static const auto characters = [] {
+            auto type = primitive_types().findSymbol(STRING_TP);
+            std::array<value_t, 256> result;
+            for (size_t i = 0; i < result.size(); i++) {
+                result[i] = NormalValue::create(type, std::string(1, static_cast<char>(i)));
+            }
+            return result;
+        }();
+
+        return characters[static_cast<unsigned char>(val)];
+    }
+
     value_t Interpreter::create_literal(int val) {
         return NormalValue::create(int_type, val);
     }
@@ -868,6 +1191,7 @@ namespace Odo::Interpreting {
             if (breaking || continuing || returning) {
                 break;
             }
+            collect_cycles();
         }
 
         currentScope = blockScope.getParent();
@@ -970,7 +1294,6 @@ namespace Odo::Interpreting {
             auto& the_symbols = Value::as<ListValue>(lst_value)->elements;
 
             bool go_backwards = node->rev.tp != Lexing::NOTHING;
-            lst_value->important = true;
 
             for(size_t i = 0; i < the_symbols.size(); i++){
                 auto actual_index = i;
@@ -996,7 +1319,82 @@ namespace Odo::Interpreting {
                     break;
                 }
             }
-            lst_value->important = false;
+        } else if (lst_value->kind() == ValueType::MapVal) {
+            auto as_map = Value::as<MapValue>(lst_value);
+            auto key_iter = currentScope->addSymbol({as_map->type->key_tp, node->var.value});
+            Symbol* value_iter = nullptr;
+            if (node->value_var.tp != Lexing::NOTHING) {
+                value_iter = currentScope->addSymbol({as_map->type->tp, node->value_var.value});
+            }
+
+            bool go_backwards = node->rev.tp != Lexing::NOTHING;
+
+            // Entries are never removed, and the ones the body adds come after these.
+            auto n_entries = as_map->entries.size();
+            for (size_t i = 0; i < n_entries; i++) {
+                auto actual_index = i;
+                if (go_backwards) {
+                    actual_index = n_entries - 1 - i;
+                }
+
+                auto& e = as_map->entries[actual_index];
+                key_iter->value = e.key;
+                if (value_iter) {
+                    value_iter->value = e.value.value;
+                }
+
+                visit(node->body);
+                if (continuing) {
+                    continuing = false;
+                    continue;
+                }
+
+                if (breaking) {
+                    breaking = false;
+                    break;
+                }
+
+                if (returning) {
+                    break;
+                }
+            }
+        } else if (lst_value->kind() == ValueType::FileVal) {
+            auto& file = *Value::as<FileValue>(lst_value)->file;
+            if (!file.is_open()) {
+                throw Exceptions::FileException(FILE_CLOSED_EXCP + file.path() + "'.");
+            } else if (file.mode() != io::File::Mode::Read) {
+                throw Exceptions::FileException(FILE_NOT_READABLE_EXCP + file.path() + "'.");
+            }
+
+            auto line_iter = currentScope->addSymbol({string_type, node->var.value});
+
+            // Only one line is held at a time, so files of any size take the same memory.
+            // The body could close the file, which ends the loop.
+            std::string line;
+            while (true) {
+                try {
+                    if (!file.is_open() || !file.read_line(line)) break;
+                } catch (Exceptions::IOException&) {
+                    throw Exceptions::FileException(COULD_NOT_READ_EXCP + file.path() + MAY_NOT_EXIST_EXCP);
+                }
+
+                line_iter->value = NormalValue::create(string_type, std::move(line));
+
+                visit(node->body);
+                if (continuing) {
+                    continuing = false;
+                    continue;
+                }
+
+                if (breaking) {
+                    breaking = false;
+                    break;
+                }
+
+                if (returning) {
+                    break;
+                }
+            }
         } else if (lst_value->type->name == STRING_TP) {
             auto iterator_decl = VarDeclarationNode::create(
                 VariableNode::create(Lexing::Token(Lexing::TokenType::ID, STRING_TP)),
@@ -1006,11 +1404,9 @@ namespace Odo::Interpreting {
             visit(iterator_decl);
 
             auto declared_iter = currentScope->findSymbol(node->var.value);
-            declared_iter->value = create_literal(std::string(1, '\0'));
 
-            auto iter_as_normal = Value::as<NormalValue>(declared_iter->value);
-
-            auto st = Value::as<NormalValue>(lst_value)->as_string();
+            // lst_value is held for the whole loop, so the body can't change the string under the view.
+            auto st = Value::as<NormalValue>(lst_value)->as_string_view();
 
             bool go_backwards = node->rev.tp != Lexing::NOTHING;
 
@@ -1018,8 +1414,7 @@ namespace Odo::Interpreting {
                 size_t actual_index = i;
                 if (go_backwards) actual_index = st.size() - 1 - i;
 
-                char s = st[actual_index];
-                iter_as_normal->val = std::string(1, s);
+                declared_iter->value = create_char_literal(st[actual_index]);
 
                 visit(node->body);
                 if (continuing) {
@@ -1069,6 +1464,15 @@ namespace Odo::Interpreting {
                 max_in_range = static_cast<int>(floor(Value::as<NormalValue>(second_visited)->as_double()));
         }
 
+        // A negative iterator indexes lists from the end, so two iterations could reach the same element.
+        // Nested parallel loops run sequentially inside of the worker that reaches them,
+        // and so does every loop when there's a single core to run on.
+        if (node->parallel && !is_worker && std::thread::hardware_concurrency() > 1 && min_in_range >= 0 && max_in_range - min_in_range > 1) {
+            run_parallel_range(node, min_in_range, max_in_range);
+            currentScope = forScope.getParent();
+            return null;
+        }
+
         bool go_backwards = node->rev.tp != Lexing::NOTHING;
         bool use_iterator = node->var.tp != Lexing::NOTHING;
 
@@ -1115,6 +1519,90 @@ namespace Odo::Interpreting {
         return null;
     }
 
+    void Interpreter::run_parallel_range(const std::shared_ptr<FoRangeNode>& node, int min_in_range, int max_in_range) {
+        bool go_backwards = node->rev.tp != Lexing::NOTHING;
+        bool use_iterator = node->var.tp != Lexing::NOTHING;
+
+        auto count = static_cast<unsigned int>(max_in_range - min_in_range);
+        auto n_workers = std::min(count, std::max(1u, std::thread::hardware_concurrency()));
+
+        // Iterations are taken in small chunks, so workers that get cheap iterations
+        // (like the rows of a fractal outside of the set) keep taking more.
+        int chunk_size = std::max(1, static_cast<int>(count / (n_workers * 8)));
+        std::atomic<int> next_chunk {min_in_range};
+
+        std::atomic<bool> failed {false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        // The workers see the scope where the loop is, not the one with this thread's iterator.
+        auto loop_parent = currentScope->getParent();
+
+        // The workers look up names in the scopes around the loop, and can declare types in the global one.
+        for (auto scope = loop_parent; scope; scope = scope->getParent()) {
+            scope->share_between_threads();
+        }
+        globalTable->share_between_threads();
+
+        auto work = [&]() {
+            auto iterScope = SymbolTable("forange:loop", {}, loop_parent);
+            Interpreter worker(*this, &iterScope);
+            Heap::Use using_heap(*worker.heap);
+            HeapProfile::Attribution attribution(worker.current_line, worker.current_col, worker.call_stack);
+
+            std::shared_ptr<NormalValue> iter_as_normal;
+            if (use_iterator) {
+                auto iter_value = worker.create_literal(0);
+                iterScope.addSymbol({int_type, node->var.value, iter_value});
+                iter_as_normal = Value::as<NormalValue>(iter_value);
+            }
+
+            try {
+                while (!failed) {
+                    int start = next_chunk.fetch_add(chunk_size);
+                    if (start >= max_in_range) break;
+                    int end = std::min(max_in_range, start + chunk_size);
+
+                    for (int i = start; i < end && !failed; i++) {
+                        auto actual_value = i;
+                        if (go_backwards) actual_value = min_in_range + max_in_range-1-i;
+
+                        if (use_iterator)
+                            iter_as_normal->val = actual_value;
+
+                        worker.visit(node->body);
+                        worker.continuing = false;
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(n_workers - 1);
+        for (unsigned int i = 1; i < n_workers; i++) {
+            threads.emplace_back(work);
+        }
+        work();
+
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void Interpreter::collect_cycles() {
+        if (!is_worker) {
+            heap->maybe_collect();
+        }
+    }
+
     value_t Interpreter::visit_While(const std::shared_ptr<WhileNode>& node) {
         auto whileScope = SymbolTable("while:loop", {}, currentScope);
         currentScope = &whileScope;
@@ -1163,6 +1651,38 @@ namespace Odo::Interpreting {
         return null;
     }
 
+    // A value that nothing else holds, like the result of an expression, is stored as it is.
+    // Anything else is copied, so that storing it doesn't make it shared.
+    static value_t copy_if_shared(value_t value) {
+        if (value->is_copyable() && value.use_count() > 1) {
+            return value->copy();
+        }
+
+        return value;
+    }
+
+    // Numbers stored where the other kind of number is expected are converted.
+    static value_t coerce_number(value_t value, Symbol* tp) {
+        if (tp->name == INT_TP && value->type->name == DOUBLE_TP) {
+            return NormalValue::create(tp, (int) Value::as<NormalValue>(value)->as_double());
+        } else if (tp->name == DOUBLE_TP && value->type->name == INT_TP) {
+            return NormalValue::create(tp, (double) Value::as<NormalValue>(value)->as_int());
+        }
+
+        return value;
+    }
+
+    // An empty map literal doesn't know its type, so it takes the one it's stored as.
+    static void retype_map(const value_t& value, Symbol* tp) {
+        if (tp->kind != SymbolType::MapType || value->kind() != ValueType::MapVal) return;
+
+        value->type = tp;
+        for (auto& e : Value::as<MapValue>(value)->entries) {
+            e.value.value = coerce_number(std::move(e.value.value), tp->tp);
+            e.value.tp = e.value.value->type;
+        }
+    }
+
     value_t Interpreter::visit_VarDeclaration(const std::shared_ptr<VarDeclarationNode>& node) {
         value_t newValue;
         if (node->initial)
@@ -1173,18 +1693,13 @@ namespace Odo::Interpreting {
         value_t valueReturn;
 
         if (node->initial && node->initial->kind() != NodeType::NoOp) {
-            if (newValue->is_copyable()) {
-                newValue = newValue->copy();
-            }
+            newValue = copy_if_shared(std::move(newValue));
 
             if (type_->name == ANY_TP) {
                 type_ = newValue->type;
             } else {
-                if (type_->name == INT_TP && newValue->type->name == DOUBLE_TP) {
-                    newValue = create_literal((int) Value::as<NormalValue>(newValue)->as_double());
-                } else if (type_->name == DOUBLE_TP && newValue->type->name == INT_TP) {
-                    newValue = create_literal((double) Value::as<NormalValue>(newValue)->as_int());
-                }
+                newValue = coerce_number(std::move(newValue), type_);
+                retype_map(newValue, type_);
             }
 
             newVar = {
@@ -1216,7 +1731,7 @@ namespace Odo::Interpreting {
         if (dimensions == 0) return sym;
 
         do {
-            tp = globalTable.addListType(prev_sym);
+            tp = globalTable->addListType(prev_sym);
 
             auto element_template_name = "__$" + tp->name + "_list_element";
 
@@ -1237,30 +1752,31 @@ namespace Odo::Interpreting {
         return tp;
     }
 
-    value_t Interpreter::visit_ListDeclaration(const std::shared_ptr<ListDeclarationNode>& node) {
+    Symbol* Interpreter::list_type_of(const std::shared_ptr<ListDeclarationNode>& node) {
         // TODO: Handle the list type.
         auto base_type = getSymbolFromNode(node->var_type);
-        Symbol* newVar;
-        value_t valueReturn = null;
-
-        Symbol* list_type;
 
-        auto found_in_table = globalTable.findSymbol(base_type->name + "[]");
+        auto found_in_table = globalTable->findSymbol(base_type->name + "[]");
         if (found_in_table) {
-            list_type = found_in_table;
-        } else {
-            list_type = globalTable.addSymbol({
-                .tp=base_type,
-                .name=base_type->name + "[]",
-                .isType=true,
-                .kind=SymbolType::ListType
-            });
+            return found_in_table;
         }
 
+        return globalTable->addSymbol({
+            .tp=base_type,
+            .name=base_type->name + "[]",
+            .isType=true,
+            .kind=SymbolType::ListType
+        });
+    }
+
+    value_t Interpreter::visit_ListDeclaration(const std::shared_ptr<ListDeclarationNode>& node) {
+        auto list_type = list_type_of(node);
+        value_t valueReturn = null;
+
         if (node->initial && node->initial->kind() != NodeType::NoOp) {
             auto newValue = visit(node->initial);
 
-            newVar = currentScope->addSymbol({
+            currentScope->addSymbol({
                 list_type,
                 node->name.value,
                 newValue
@@ -1279,31 +1795,96 @@ namespace Odo::Interpreting {
         return valueReturn;
     }
 
-    value_t Interpreter::visit_Assignment(const std::shared_ptr<AssignmentNode>& node) {
-        auto varSym = getSymbolFromNode(node->expr);
-        auto newValue = visit(node->val);
+    static std::string concat(std::string_view a, std::string_view b) {
+        std::string result;
+        result.reserve(a.size() + b.size());
+        result.append(a).append(b);
+        return result;
+    }
 
-        if (varSym->value) {
-            auto theValue = varSym->value;
+    // Whether both nodes name the same variable, without anything that could change what they refer to in between.
+    static bool is_same_variable(const std::shared_ptr<Node>& a, const std::shared_ptr<Node>& b) {
+        if (a->kind() != b->kind()) return false;
 
-            if (newValue->is_copyable()) {
-                newValue = newValue->copy();
-            }
+        if (a->kind() == NodeType::Variable) {
+            return Node::as<VariableNode>(a)->token.value == Node::as<VariableNode>(b)->token.value;
+        } else if (a->kind() == NodeType::MemberVar) {
+            auto a_member = Node::as<MemberVarNode>(a);
+            auto b_member = Node::as<MemberVarNode>(b);
+            return a_member->name.value == b_member->name.value && is_same_variable(a_member->inst, b_member->inst);
+        }
+
+        return false;
+    }
+
+    bool Interpreter::append_in_place(const std::shared_ptr<AssignmentNode>& node, Symbol* varSym) {
+        if (!varSym || !varSym->value || node->val->kind() != NodeType::BinOp) return false;
+
+        auto operation = Node::as<BinOpNode>(node->val);
+        if (operation->token.tp != Lexing::PLUS || !is_same_variable(operation->left, node->expr)) return false;
+
+        auto target = Value::as<NormalValue>(varSym->value);
+        if (!target || target->type->name != STRING_TP) return false;
+
+        auto added = visit(operation->right);
+        std::string formatted;
+        std::string_view addition;
+        if (added->type->name == STRING_TP) {
+            // If this is the same string, added holds it too, and it won't be appended to in place.
+            addition = Value::as<NormalValue>(added)->as_string_view();
         } else {
-            if (newValue->is_copyable()) {
-                newValue = newValue->copy();
+            formatted = added->to_string();
+            addition = formatted;
+        }
+
+        // The right side could have assigned something else to the variable, or kept its value somewhere.
+        // Either way the sum is built like any other, from the value the left side had.
+        if (varSym->value != target || target.use_count() != 2) {
+            varSym->value = create_literal(concat(target->as_string_view(), addition));
+            return true;
+        }
+
+        // std::string grows geometrically, so a loop of appends is linear in the final length.
+        target->own_string() += addition;
+        return true;
+    }
+
+    value_t Interpreter::visit_Assignment(const std::shared_ptr<AssignmentNode>& node) {
+        Symbol* varSym;
+        if (node->expr->kind() == NodeType::Index) {
+            auto as_index = Node::as<IndexNode>(node->expr);
+            auto source = visit(as_index->val);
+
+            if (source->kind() == ValueType::MapVal) {
+                // Assigning to a key that isn't there adds it. Both sides are evaluated first,
+                // so the map doesn't change if either of them fails.
+                auto as_map = Value::as<MapValue>(source);
+                auto key = copy_if_shared(visit(as_index->expr));
+                auto newValue = coerce_number(copy_if_shared(visit(node->val)), as_map->type->tp);
+
+                as_map->set(std::move(key), std::move(newValue));
+                return null;
             }
 
+            varSym = getIndexSymbol(source, as_index);
+        } else {
+            varSym = getSymbolFromNode(node->expr);
+        }
+
+        if (append_in_place(node, varSym)) {
+            return null;
+        }
+
+        auto newValue = copy_if_shared(visit(node->val));
+
+        if (!varSym->value) {
             if (varSym->tp->name == ANY_TP) {
                 varSym->tp = newValue->type;
             } else {
-                if (varSym->tp->name == INT_TP && newValue->type->name == DOUBLE_TP) {
-                    newValue = create_literal((int) Value::as<NormalValue>(newValue)->as_double());
-                } else if (varSym->tp->name == DOUBLE_TP && newValue->type->name == INT_TP) {
-                    newValue = create_literal((double) Value::as<NormalValue>(newValue)->as_int());
-                }
+                newValue = coerce_number(std::move(newValue), varSym->tp);
             }
         }
+        retype_map(newValue, varSym->tp);
 
         varSym->value = newValue;
         return null;
@@ -1313,7 +1894,7 @@ namespace Odo::Interpreting {
         auto found = currentScope->findSymbol(node->token.value);
 
         if (found->value) {
-            return (found->value == nullptr) ? null : found->value;
+            return InstanceValue::owned(found->value);
         } else {
             return null;
         }
@@ -1323,18 +1904,16 @@ namespace Odo::Interpreting {
         auto visited_val = visit(node->val);
 
         if (visited_val->type->name == STRING_TP) {
-            auto str = Value::as<NormalValue>(visited_val)->as_string();
+            auto str = Value::as<NormalValue>(visited_val)->as_string_view();
 
             auto visited_indx = visit(node->expr);
             auto int_indx = Value::as<NormalValue>(visited_indx)->as_int();
 
             if (int_indx >= 0 && static_cast<size_t>(int_indx) < str.size()) {
-                std::string result(1, str[int_indx]);
-                return create_literal_from_string(result, STRING_TP);
+                return create_char_literal(str[int_indx]);
             } else if (int_indx < 0 && static_cast<size_t>(abs(int_indx)) <= str.size()) {
                 size_t actual_indx = str.size() + int_indx;
-                std::string result(1, str[actual_indx]);
-                return create_literal_from_string(result, STRING_TP);
+                return create_char_literal(str[actual_indx]);
             } else {
                 throw Exceptions::ValueException(
                         INDX_LST_OB_EXCP,
@@ -1342,21 +1921,20 @@ namespace Odo::Interpreting {
                         current_col
                 );
             }
+        } else if (visited_val->kind() == ValueType::MapVal) {
+            return getIndexSymbol(visited_val, node)->value;
         } else {
-            auto list_value = Value::as<ListValue>(visited_val)->as_list_value();
+            // Read the element in place. Going through as_list_value would copy every
+            // element just to return one, and would read elements other threads may be writing.
+            auto& elements = Value::as<ListValue>(visited_val)->elements;
             auto visited_indx = visit(node->expr);
             auto int_indx = Value::as<NormalValue>(visited_indx)->as_int();
 
-            if (int_indx >= 0 && static_cast<size_t>(int_indx) < list_value.size()) {
-                return list_value[int_indx];
-            } else if (int_indx < 0 && static_cast<size_t>(abs(int_indx)) <= list_value.size()) {
-                size_t actual_indx = list_value.size() + int_indx;
-                return list_value[actual_indx];
-            } if (int_indx >= 0 && static_cast<size_t>(int_indx) < list_value.size()) {
-                return list_value[int_indx];
-            } else if (int_indx < 0 && static_cast<size_t>(abs(int_indx)) <= list_value.size()) {
-                size_t actual_indx = list_value.size() - int_indx;
-                return list_value[actual_indx];
+            if (int_indx >= 0 && static_cast<size_t>(int_indx) < elements.size()) {
+                return elements[int_indx].value;
+            } else if (int_indx < 0 && static_cast<size_t>(abs(int_indx)) <= elements.size()) {
+                size_t actual_indx = elements.size() + int_indx;
+                return elements[actual_indx].value;
             } else {
                 throw Exceptions::ValueException(
                     INDX_LST_OB_EXCP,
@@ -1381,21 +1959,15 @@ namespace Odo::Interpreting {
                 auto list_type_name = visited_element->type->name + "[]";
 
                 // TODO: Fix. Apparently list types are stored only in the global scope.
-                auto found_type = globalTable.findSymbol(list_type_name);
+                auto found_type = globalTable->findSymbol(list_type_name);
                 if (found_type) {
                     list_t = found_type;
                 } else {
-                    list_t = globalTable.addListType(type_of_el);
+                    list_t = globalTable->addListType(type_of_el);
                 }
             }
 
-            value_t actual_value;
-
-            if (visited_element->is_copyable()) {
-                actual_value = visited_element->copy();
-            } else {
-                actual_value = visited_element;
-            }
+            auto actual_value = copy_if_shared(std::move(visited_element));
 
             auto el_symbol = Symbol{
                 type_of_el,
@@ -1410,7 +1982,7 @@ namespace Odo::Interpreting {
         if (list_t) {
             list_type = list_t;
         } else {
-            list_type = globalTable.addListType(any_type());
+            list_type = globalTable->addListType(any_type());
         }
 
         auto new_list_value = ListValue::create(list_type, std::move(list_syms));
@@ -1418,6 +1990,33 @@ namespace Odo::Interpreting {
         return new_list_value;
     }
 
+    value_t Interpreter::visit_MapExpression(const std::shared_ptr<MapExpressionNode>& node) {
+        auto result = MapValue::create(nullptr);
+        Symbol* key_type = nullptr;
+        Symbol* value_type = nullptr;
+
+        for (size_t i = 0; i < node->keys.size(); i++) {
+            auto key = copy_if_shared(visit(node->keys[i]));
+            auto value = copy_if_shared(visit(node->values[i]));
+
+            if (!key_type) {
+                key_type = key->type;
+                value_type = value->type;
+            } else if (value_type != value->type) {
+                value_type = any_type();
+            }
+
+            result->set(std::move(key), std::move(value));
+        }
+
+        if (!key_type) {
+            key_type = value_type = any_type();
+        }
+        result->type = globalTable->addMapType(key_type, value_type);
+
+        return result;
+    }
+
     value_t Interpreter::visit_BinOp(const std::shared_ptr<BinOpNode>& node) {
         // TODO: Add shortcut-circuit evaluation now that I don't need
         //       to check the exact types of the values at runtime.
@@ -1443,16 +2042,16 @@ namespace Odo::Interpreting {
 
     value_t Interpreter::visit_BinOp_arit(const std::shared_ptr<BinOpNode>& node) {
         auto leftVisited = visit(node->left);
-        leftVisited->important = true;
         auto rightVisited = visit(node->right);
-        leftVisited->important = false;
 
         auto coerced = coerce_type(leftVisited, rightVisited);
-        leftVisited = coerced.first;
-        rightVisited = coerced.second;
+        leftVisited = std::move(coerced.first);
+        rightVisited = std::move(coerced.second);
 
         switch (node->token.tp) {
             case Lexing::PLUS: {
+                // Nothing else holds a value made by the expression on the left, like the partial sum of a + b + c.
+                bool left_is_temporary = leftVisited.use_count() == 1;
                 auto left_as_normal = Value::as<NormalValue>(leftVisited);
                 auto right_as_normal = Value::as<NormalValue>(rightVisited);
                 if (leftVisited->kind() == ValueType::ListVal) {
@@ -1510,15 +2109,27 @@ namespace Odo::Interpreting {
                         new_elements.push_back(new_symbol);
 
                         new_list = ListValue::create(
-                                globalTable.addListType(val->type),
+                                globalTable->addListType(val->type),
                                 std::move(new_elements)
                         );
                         return new_list;
                     }
                 } else if (leftVisited->type->name == STRING_TP) {
-                    return create_literal(left_as_normal->as_string() + rightVisited->to_string());
+                    if (left_is_temporary) {
+                        auto& left_string = left_as_normal->own_string();
+                        if (rightVisited->type->name == STRING_TP) {
+                            left_string += right_as_normal->as_string_view();
+                        } else {
+                            left_string += rightVisited->to_string();
+                        }
+                        return leftVisited;
+                    }
+                    if (rightVisited->type->name == STRING_TP) {
+                        return create_literal(concat(left_as_normal->as_string_view(), right_as_normal->as_string_view()));
+                    }
+                    return create_literal(concat(left_as_normal->as_string_view(), rightVisited->to_string()));
                 } else if (rightVisited->type->name == STRING_TP) {
-                    return create_literal(leftVisited->to_string() + right_as_normal->as_string());
+                    return create_literal(concat(leftVisited->to_string(), right_as_normal->as_string_view()));
                 } else if (leftVisited->type == rightVisited->type) {
                     if (leftVisited->type->name == INT_TP) {
                         auto result = left_as_normal->as_int() + right_as_normal->as_int();
@@ -1556,18 +2167,19 @@ namespace Odo::Interpreting {
                     }
                 } else if (leftVisited->kind() == ValueType::ListVal && rightVisited->type->name == INT_TP) {
                     int right_as_int = right_as_normal->as_int();
+                    auto& repeated = Value::as<ListValue>(leftVisited)->elements;
                     std::vector<Symbol> new_elements;
+                    new_elements.reserve(repeated.size() * std::max(right_as_int, 0));
 
                     for (int i = 0; i < right_as_int; i++) {
-                        for (const auto &el : Value::as<ListValue>(leftVisited)->elements) {
+                        for (const auto &el : repeated) {
                             auto val = el.value;
 
                             if (val->is_copyable()) {
                                 val = val->copy();
                             }
 
-                            Symbol new_symbol = {el.tp, el.name, val};
-                            new_elements.push_back(new_symbol);
+                            new_elements.push_back({el.tp, el.name, std::move(val)});
                         }
                     }
 
@@ -1575,9 +2187,10 @@ namespace Odo::Interpreting {
 
                     return new_list;
                 } else if (leftVisited->type->name == STRING_TP && rightVisited->type->name == INT_TP) {
-                    std::string left_as_string = left_as_normal->as_string();
+                    auto left_as_string = left_as_normal->as_string_view();
                     int right_as_int = right_as_normal->as_int();
                     std::string new_string;
+                    new_string.reserve(left_as_string.size() * std::max(right_as_int, 0));
 
                     for (int i = 0; i < right_as_int; i++) {
                         new_string += left_as_string;
@@ -1636,9 +2249,7 @@ namespace Odo::Interpreting {
 
     value_t Interpreter::visit_BinOp_equa(const std::shared_ptr<BinOpNode>& node) {
         auto leftVisited = visit(node->left);
-        leftVisited->important = true;
         auto rightVisited = visit(node->right);
-        leftVisited->important = false;
 
         switch (node->token.tp) {
             case Lexing::EQU: {
@@ -1670,7 +2281,7 @@ namespace Odo::Interpreting {
                     auto result = left_as_normal->as_bool() == right_as_normal->as_bool();
                     return create_literal(result);
                 } else if (leftVisited->type->name == STRING_TP) {
-                    auto result = left_as_normal->as_string() == right_as_normal->as_string();
+                    auto result = left_as_normal->as_string_view() == right_as_normal->as_string_view();
                     return create_literal(result);
                 } else {
                     return create_literal(false);
@@ -1706,7 +2317,7 @@ namespace Odo::Interpreting {
                     auto result = left_as_normal->as_bool() != right_as_normal->as_bool();
                     return create_literal(result);
                 } else if (leftVisited->type->name == STRING_TP) {
-                    auto result = left_as_normal->as_string() != right_as_normal->as_string();
+                    auto result = left_as_normal->as_string_view() != right_as_normal->as_string_view();
                     return create_literal(result);
                 } else {
                     return create_literal(true);
@@ -1721,9 +2332,7 @@ namespace Odo::Interpreting {
 
     value_t Interpreter::visit_BinOp_rela(const std::shared_ptr<BinOpNode>& node) {
         auto leftVisited = visit(node->left);
-        leftVisited->important = true;
         auto rightVisited = visit(node->right);
-        leftVisited->important = false;
 
         auto coerced = coerce_type(leftVisited, rightVisited);
 
@@ -1789,16 +2398,11 @@ namespace Odo::Interpreting {
             case Lexing::PLUS:
                 return result_as_normal;
             case Lexing::MINUS:
+                // Negating creates a new value. The visited one may belong to a variable.
                 if (result->type->name == INT_TP) {
-                    auto actual_value = result_as_normal->as_int();
-
-                    result_as_normal->val = actual_value * -1;
-                    return result;
+                    return create_literal(result_as_normal->as_int() * -1);
                 } else {
-                    auto actual_value = result_as_normal->as_double();
-
-                    result_as_normal->val = actual_value * -1;
-                    return result;
+                    return create_literal(result_as_normal->as_double() * -1);
                 }
             default:
                 break;
@@ -1815,7 +2419,6 @@ namespace Odo::Interpreting {
         };
 
         auto moduleValue = ModuleValue::create(null->type, module_scope);
-        moduleValue->important = true;
 
         auto temp = currentScope;
         currentScope = &moduleValue->ownScope;
@@ -1824,7 +2427,6 @@ namespace Odo::Interpreting {
         }
 
         currentScope = temp;
-        moduleValue->important = false;
 
         currentScope->addSymbol({nullptr, node->name.value, moduleValue, false, SymbolType::ModuleSymbol});
 
@@ -1853,7 +2455,7 @@ namespace Odo::Interpreting {
         }
 
         auto func_name = Symbol::constructFuncTypeName(ret_type_symbol, as_function_types);
-        auto func_type = globalTable.addFuncType(ret_type_symbol, func_name);
+        auto func_type = globalTable->addFuncType(ret_type_symbol, func_name);
 
         currentScope->addAlias(node->name.value, func_type);
 
@@ -1870,10 +2472,10 @@ namespace Odo::Interpreting {
 
         auto typeName = Symbol::constructFuncTypeName(returnType, paramTypes);
 
-        auto typeOfFunc = globalTable.findSymbol(typeName);
+        auto typeOfFunc = globalTable->findSymbol(typeName);
 
         if (!typeOfFunc) {
-            typeOfFunc = globalTable.addFuncType(returnType, paramTypes);
+            typeOfFunc = globalTable->addFuncType(returnType, paramTypes);
         }
 
         auto funcValue = FunctionValue::create(typeOfFunc, node->params, node->body, currentScope);
@@ -1881,7 +2483,7 @@ namespace Odo::Interpreting {
         return funcValue;
     }
 
-    value_t Interpreter::visit_FuncDecl(const std::shared_ptr<FuncDeclNode>& node){
+    Symbol* Interpreter::function_type_of(const std::shared_ptr<FuncDeclNode>& node) {
         Interpreting::Symbol* returnType = nullptr;
 
         if (node->retType->kind() != Parsing::NodeType::NoOp) {
@@ -1904,12 +2506,18 @@ namespace Odo::Interpreting {
 
         auto typeName = Symbol::constructFuncTypeName(returnType, paramTypes);
 
-        auto typeOfFunc = globalTable.findSymbol(typeName);
+        auto typeOfFunc = globalTable->findSymbol(typeName);
 
         if (!typeOfFunc) {
-            typeOfFunc = globalTable.addFuncType(returnType, typeName);
+            typeOfFunc = globalTable->addFuncType(returnType, typeName);
         }
 
+        return typeOfFunc;
+    }
+
+    value_t Interpreter::visit_FuncDecl(const std::shared_ptr<FuncDeclNode>& node){
+        auto typeOfFunc = function_type_of(node);
+
         auto funcValue = FunctionValue::create(typeOfFunc, node->params, node->body, currentScope, node->name.value);
 
         currentScope->addSymbol({
@@ -1936,22 +2544,12 @@ namespace Odo::Interpreting {
                 auto num_args = node->args.size();
                 std::vector<value_t> arguments_visited;
 
-                std::vector<bool> was_important{};
                 for(size_t i = 0; i < num_args; i++){
                     auto& arg = node->args[i];
-                    auto v = visit(arg);
-                    was_important.push_back(v->important);
-                    v->important = true;
-                    arguments_visited.push_back(std::move(v));
-                }
-
-                auto result = found_in_natives->second(arguments_visited);
-                for (size_t i = 0; i < arguments_visited.size(); i++) {
-                    if (!was_important[i])
-                        arguments_visited[i]->important = false;
+                    arguments_visited.push_back(visit(arg));
                 }
 
-                return result;
+                return found_in_natives->second(arguments_visited);
             }
         }
 
@@ -1979,7 +2577,7 @@ namespace Odo::Interpreting {
                             }
                         }
                     }
-                    args.push_back(Value::as<NormalValue>(val)->val);
+                    args.push_back(Value::as<NormalValue>(val)->primitive());
                 }
                 auto result = as_native->fn(args);
 
@@ -1999,61 +2597,84 @@ namespace Odo::Interpreting {
         } else {
             auto as_function_value = Value::as<FunctionValue>(fVal);
 
-            auto funcScope = SymbolTable("func-scope", {}, as_function_value->parentScope);
-            auto calleeScope = currentScope;
-
-            std::vector<std::shared_ptr<Node>> newDecls;
-            std::vector< std::pair<Lexing::Token, value_t> > initValues;
-
-            for (size_t i = 0; i < as_function_value->params.size(); i++) {
-                auto par = as_function_value->params[i];
-                if (node->args.size() > i) {
-                    switch (par->kind()) {
-                        case NodeType::VarDeclaration:
-                        {
-                            auto newValue = visit(node->args[i]);
-                            if (newValue->is_copyable()) {
-                                newValue = newValue->copy();
-                            }
-                            initValues.emplace_back(Node::as<VarDeclarationNode>(par)->name, newValue);
-                            break;
-                        }
-                        case NodeType::ListDeclaration:
-                        {
-                            auto newValue = visit(node->args[i]);
-                            initValues.emplace_back(Node::as<ListDeclarationNode>(par)->name, newValue);
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                }
-
-                newDecls.push_back(par);
+            std::vector<value_t> arguments;
+            auto n_arguments = std::min(as_function_value->params.size(), node->args.size());
+            for (size_t i = 0; i < n_arguments; i++) {
+                arguments.push_back(visit(node->args[i]));
             }
 
-            currentScope = &funcScope;
+            return call_function(as_function_value, std::move(arguments));
+        }
+    }
 
-            call_stack.push_back({as_function_value->name, current_line, current_col});
+    value_t Interpreter::call_function(const std::shared_ptr<FunctionValue>& function, std::vector<value_t> arguments) {
+        // Tasks call functions on workers, on threads of their own.
+        Heap::Use using_heap(*heap);
+        HeapProfile::Attribution attribution(current_line, current_col, call_stack);
+        RepeatedCall call(*this, function);
+        return call(std::move(arguments));
+    }
 
-            for (size_t i = 0; i < newDecls.size(); i++) {
-                visit(newDecls[i]);
+    RepeatedCall::RepeatedCall(Interpreter& inter_, std::shared_ptr<FunctionValue> function_)
+        : inter(inter_)
+        , function(std::move(function_))
+        , scope("func-scope", {}, function->parentScope) {
+        auto calleeScope = inter.currentScope;
+        inter.currentScope = &scope;
 
-                if (i < initValues.size()) {
-                    auto newVar = currentScope->findSymbol(initValues[i].first.value);
-                    newVar->value = initValues[i].second;
-                }
+        for (const auto& par : function->params) {
+            inter.visit(par);
+
+            switch (par->kind()) {
+                case NodeType::VarDeclaration:
+                    params.emplace_back(scope.findSymbol(Node::as<VarDeclarationNode>(par)->name.value, false), true);
+                    break;
+                case NodeType::ListDeclaration:
+                    // Lists are passed by reference.
+                    params.emplace_back(scope.findSymbol(Node::as<ListDeclarationNode>(par)->name.value, false), false);
+                    break;
+                default:
+                    params.emplace_back(nullptr, false);
+                    break;
             }
+        }
 
-            auto body_as_ast = as_function_value->body;
+        inter.currentScope = calleeScope;
+    }
 
-            auto result = visit(body_as_ast);
-            currentScope = calleeScope;
+    value_t RepeatedCall::operator()(std::vector<value_t> arguments) {
+        for (size_t i = 0; i < params.size() && i < arguments.size(); i++) {
+            auto [param, copied] = params[i];
+            if (!param) continue;
 
-            result->important = false;
-            call_stack.pop_back();
-            return result;
+            auto& newValue = arguments[i];
+            if (copied && newValue->is_copyable()) {
+                newValue = newValue->copy();
+            }
+            param->value = std::move(newValue);
+        }
+
+        auto calleeScope = inter.currentScope;
+        inter.currentScope = &scope;
+        inter.call_stack.push_back({function->name, inter.current_line, inter.current_col});
+
+        auto result = inter.visit(function->body);
+
+        inter.currentScope = calleeScope;
+        inter.call_stack.pop_back();
+        return result;
+    }
+
+    TaskPool& Interpreter::get_task_pool() {
+        if (!task_pool) {
+            task_pool = std::make_unique<TaskPool>();
         }
+
+        return *task_pool;
+    }
+
+    std::unique_ptr<Interpreter> Interpreter::create_worker() {
+        return std::unique_ptr<Interpreter>(new Interpreter(*this, globalTable.get()));
     }
 
     value_t Interpreter::visit_FuncBody(const std::shared_ptr<FuncBodyNode>& node) {
@@ -2067,6 +2688,7 @@ namespace Odo::Interpreting {
             if (returning) {
                 break;
             }
+            collect_cycles();
         }
 
         currentScope = temp;
@@ -2078,7 +2700,6 @@ namespace Odo::Interpreting {
 
     value_t Interpreter::visit_Return(const std::shared_ptr<ReturnNode>& node) {
         returning = visit(node->val);
-        returning->important = true;
         return null;
     }
 
@@ -2157,10 +2778,10 @@ namespace Odo::Interpreting {
 
         auto typeName = Symbol::constructFuncTypeName(retType, paramTypes);
 
-        auto typeOfFunc = globalTable.findSymbol(typeName);
+        auto typeOfFunc = globalTable->findSymbol(typeName);
 
         if (!typeOfFunc) {
-            typeOfFunc = globalTable.addFuncType(retType, typeName);
+            typeOfFunc = globalTable->addFuncType(retType, typeName);
         }
 
         auto funcValue = FunctionValue::create(typeOfFunc, node->params, node->body, currentScope);
@@ -2170,152 +2791,264 @@ namespace Odo::Interpreting {
         return null;
     }
 
-    value_t Interpreter::visit_ConstructorCall(const std::shared_ptr<ConstructorCallNode>& node) {
-        if (call_stack.size() >= MAX_CALL_DEPTH) {
-            throw Exceptions::RecursionException(CALL_DEPTH_EXC_EXCP, current_line, current_col);
-        }
-
-        auto constr = currentScope->findSymbol(node->t.value);
+    ClassLayout::Constructor Interpreter::constructor_layout(const std::shared_ptr<ConstructorDeclNode>& node, size_t level) {
+        ClassLayout::Constructor constructor{node, level, {}, {}, {}};
 
-        auto fVal = constr ? constr->value : nullptr;
+        for (const auto& par : node->params) {
+            std::string name;
+            Symbol* tp = nullptr;
+            if (par->kind() == NodeType::VarDeclaration) {
+                auto as_var_declaration = Node::as<VarDeclarationNode>(par);
+                name = as_var_declaration->name.value;
+                tp = getSymbolFromNode(as_var_declaration->var_type);
+            } else if (par->kind() == NodeType::ListDeclaration) {
+                auto as_list_declaration = Node::as<ListDeclarationNode>(par);
+                name = as_list_declaration->name.value;
+                tp = list_type_of(as_list_declaration);
+            }
 
-        // If there's no constructor, just ignore it.
-        if (!fVal) {
-            constructorParams.clear();
-            constructorParams.shrink_to_fit();
-            return null;
+            if (!name.empty()) {
+                constructor.names[name] = constructor.param_names.size();
+            }
+            constructor.param_names.push_back(std::move(name));
+            constructor.param_types.push_back(tp);
         }
 
-        auto as_function_value = Value::as<FunctionValue>(fVal);
-        SymbolTable funcScope = {"constructor-scope", {}, as_function_value->parentScope};
-        auto calleeScope = currentScope;
+        return constructor;
+    }
 
-        std::vector<std::shared_ptr<Node>> newDecls;
-        std::vector< std::pair<Lexing::Token, value_t> > initValues;
-
-        for (size_t i = 0; i < as_function_value->params.size(); i++) {
-            auto par = as_function_value->params[i];
-            if (constructorParams.size() > i) {
-                Lexing::Token tok{Lexing::NOTHING, ""};
-                switch (par->kind()) {
-                    case NodeType::VarDeclaration:
-                        tok = Node::as<VarDeclarationNode>(par)->name;
-                        break;
-                    case NodeType::ListDeclaration:
-                        tok = Node::as<ListDeclarationNode>(par)->name;
-                        break;
-                    default:
-                        break;
-                }
-
-                if (tok.tp != Lexing::NOTHING) {
-                    auto newValue = constructorParams[i];
-                    if (newValue->is_copyable()) {
-                        newValue = newValue->copy();
+    std::shared_ptr<const ClassLayout> Interpreter::layout_of(const std::shared_ptr<ClassValue>& cls) {
+        // Workers could instantiate the same class for the first time at once.
+        std::call_once(cls->layout_built, [&] {
+            auto layout = std::make_shared<ClassLayout>();
+            layout->slot_names.emplace_back(THIS_VAR);
+            layout->names[THIS_VAR] = ClassLayout::this_slot;
+
+            std::vector<std::shared_ptr<ClassValue>> chain = {cls};
+            while (chain.front()->type->tp != nullptr) {
+                chain.insert(chain.begin(), Value::as<ClassValue>(chain.front()->type->tp->value));
+            }
+
+            // The types are found from where the class was declared, like they were for every instance.
+            auto prevScope = currentScope;
+            currentScope = cls->parentScope;
+
+            for (size_t level_index = 0; level_index < chain.size(); level_index++) {
+                auto& current = chain[level_index];
+                ClassLayout::Level level;
+                level.names[THIS_VAR] = ClassLayout::this_slot;
+
+                for (auto& st : Node::as<ClassBodyNode>(current->body)->statements) {
+                    if (st->kind() == NodeType::StaticStatement) continue;
+
+                    ClassLayout::Member member{st};
+                    std::string name;
+                    switch (st->kind()) {
+                        case NodeType::VarDeclaration: {
+                            auto as_var_declaration = Node::as<VarDeclarationNode>(st);
+                            name = as_var_declaration->name.value;
+                            member.tp = getSymbolFromNode(as_var_declaration->var_type);
+                            break;
+                        }
+                        case NodeType::ListDeclaration: {
+                            auto as_list_declaration = Node::as<ListDeclarationNode>(st);
+                            name = as_list_declaration->name.value;
+                            member.tp = list_type_of(as_list_declaration);
+                            break;
+                        }
+                        case NodeType::FuncDecl: {
+                            auto as_func_declaration = Node::as<FuncDeclNode>(st);
+                            name = as_func_declaration->name.value;
+                            member.tp = function_type_of(as_func_declaration);
+                            break;
+                        }
+                        case NodeType::ConstructorDecl:
+                            // It's not a member, instances run it right after they're made.
+                            layout->constructor = constructor_layout(Node::as<ConstructorDeclNode>(st), level_index);
+                            continue;
+                        default:
+                            // Anything else runs in the scope of the level, like it would in a function.
+                            break;
+                    }
+
+                    if (!name.empty()) {
+                        member.slot = layout->slot_names.size();
+                        layout->slot_names.push_back(name);
+                        level.names[name] = member.slot;
+                        layout->names[name] = member.slot;
                     }
-                    initValues.emplace_back(tok, newValue);
+
+                    level.members.push_back(std::move(member));
                 }
+
+                layout->levels.push_back(std::move(level));
             }
 
-            newDecls.push_back(par);
-        }
+            currentScope = prevScope;
+            cls->layout = std::move(layout);
+        });
 
-        currentScope = &funcScope;
+        return cls->layout;
+    }
 
-        call_stack.push_back({"<constructor>", current_line, current_col});
+    void Interpreter::init_members(const std::shared_ptr<InstanceValue>& instance, const ClassLayout::Level& level, SymbolTable* scope) {
+        auto prevScope = currentScope;
+        currentScope = scope;
+
+        for (auto& member : level.members) {
+            if (member.slot == ClassLayout::no_slot) {
+                visit(member.statement);
+                continue;
+            }
 
-        for (size_t i = 0; i < newDecls.size(); i++) {
-            visit(newDecls[i]);
+            auto& slot = instance->slots[member.slot];
+            slot.tp = member.tp;
+            slot.table = scope;
 
-            if (i < initValues.size()) {
-                auto newVar = currentScope->findSymbol(initValues[i].first.value);
-                newVar->value = initValues[i].second;
+            switch (member.statement->kind()) {
+                case NodeType::VarDeclaration: {
+                    auto as_var_declaration = Node::as<VarDeclarationNode>(member.statement);
+                    if (as_var_declaration->initial && as_var_declaration->initial->kind() != NodeType::NoOp) {
+                        auto newValue = copy_if_shared(visit(as_var_declaration->initial));
+
+                        if (member.tp->name == ANY_TP) {
+                            slot.tp = newValue->type;
+                        } else {
+                            newValue = coerce_number(std::move(newValue), member.tp);
+                            retype_map(newValue, member.tp);
+                        }
+
+                        slot.value = std::move(newValue);
+                    }
+                    break;
+                }
+                case NodeType::ListDeclaration: {
+                    auto as_list_declaration = Node::as<ListDeclarationNode>(member.statement);
+                    if (as_list_declaration->initial && as_list_declaration->initial->kind() != NodeType::NoOp) {
+                        slot.value = visit(as_list_declaration->initial);
+                    }
+                    break;
+                }
+                case NodeType::FuncDecl: {
+                    auto as_func_declaration = Node::as<FuncDeclNode>(member.statement);
+                    auto method = FunctionValue::create(member.tp, as_func_declaration->params, as_func_declaration->body, scope, as_func_declaration->name.value);
+                    method->instance = instance;
+                    heap->track(method);
+
+                    slot.value = std::move(method);
+                    slot.kind = SymbolType::FunctionSymbol;
+                    break;
+                }
+                default:
+                    break;
             }
         }
 
-        visit(as_function_value->body);
-        currentScope = calleeScope;
-        call_stack.pop_back();
+        currentScope = prevScope;
+    }
 
-        constructorParams.clear();
-        constructorParams.shrink_to_fit();
+    void Interpreter::construct(const ClassLayout::Constructor& constructor, Symbol* frame, size_t n_args, SymbolTable* levelScope) {
+        if (call_stack.size() >= MAX_CALL_DEPTH) {
+            throw Exceptions::RecursionException(CALL_DEPTH_EXC_EXCP, current_line, current_col);
+        }
 
-        return null;
-    }
+        auto as_constructor = Node::as<ConstructorDeclNode>(constructor.declaration);
 
-    value_t Interpreter::visit_ClassInitializer(const std::shared_ptr<ClassInitializerNode>& node) {
-        auto classInit = getSymbolFromNode(node->cls);
-        auto classVal = Value::as<ClassValue>(classInit->value);
+        SymbolTable frameScope{"constructor", {}, levelScope};
+        frameScope.setSlots(&constructor.names, frame);
 
-        SymbolTable instanceScope{"instance-" + classInit->name + "-scope", {}, classVal->parentScope};
+        auto calleeScope = currentScope;
+        currentScope = &frameScope;
+
+        // The parameters that weren't given take their default values, which can use the ones before them.
+        for (auto i = n_args; i < as_constructor->params.size(); i++) {
+            auto par = as_constructor->params[i];
+            std::shared_ptr<Node> initial;
+            if (par->kind() == NodeType::VarDeclaration) {
+                initial = Node::as<VarDeclarationNode>(par)->initial;
+            } else if (par->kind() == NodeType::ListDeclaration) {
+                initial = Node::as<ListDeclarationNode>(par)->initial;
+            }
 
-        auto newInstance = InstanceValue::create(classInit, classVal, instanceScope);
-        newInstance->important = true;
+            if (!initial || initial->kind() == NodeType::NoOp || !frame[i].tp) continue;
 
-        std::vector<value_t> newParams;
-        newParams.reserve(node->params.size());
-        for (const auto& v : node->params) newParams.push_back(visit(v));
-        constructorParams = newParams;
+            auto newValue = copy_if_shared(visit(initial));
+            if (frame[i].tp->name == ANY_TP) {
+                frame[i].tp = newValue->type;
+            } else {
+                newValue = coerce_number(std::move(newValue), frame[i].tp);
+            }
+            frame[i].value = std::move(newValue);
+        }
 
-        auto tempScope = currentScope;
-        currentScope = &newInstance->ownScope;
+        call_stack.push_back({"<constructor>", current_line, current_col});
 
-        auto thisSym = currentScope->addSymbol({
-           classInit,
-           THIS_VAR,
-           newInstance
-        });
+        visit(as_constructor->body);
+        currentScope = calleeScope;
+        call_stack.pop_back();
+    }
 
-        auto currentClass = classVal;
-        auto node_as_class_body = Node::as<ClassBodyNode>(currentClass->body);
-        auto myInstanceBody = InstanceBodyNode::create(node_as_class_body->statements);
+    value_t Interpreter::visit_ClassInitializer(const std::shared_ptr<ClassInitializerNode>& node) {
+        auto classInit = getSymbolFromNode(node->cls);
+        auto classVal = Value::as<ClassValue>(classInit->value);
+        auto layout = layout_of(classVal);
 
-        auto mainScope = new SymbolTable{
-            "inherited-scope-0",
-            {{THIS_VAR, *thisSym}},
-            classVal->parentScope
-        };
-        std::vector<std::shared_ptr<Node>> inheritedBody = {std::move(myInstanceBody)};
-        std::vector<SymbolTable*> inheritedScopes = {mainScope};
-
-        int level = 1;
-        while (currentClass->type->tp != nullptr) {
-            auto upperValue = currentClass->type->tp->value;
-
-            currentClass = Value::as<ClassValue>(upperValue);
-            auto inherBody = InstanceBodyNode::create(Node::as<ClassBodyNode>(currentClass->body)->statements);
-
-            // This process would break here because setting the parent takes the address of a local object.
-            // I need to clean this up. Raw pointers are gonna be a memory leak for a while.
-            auto inherScope =new SymbolTable{
-                "inherited-scope-" + std::to_string(level++),
-                {{THIS_VAR, *thisSym}},
-                inheritedScopes[0]
-            };
+        auto newInstance = InstanceValue::create(classInit, classVal, layout);
 
-            inheritedBody.push_back(inherBody);
-            inheritedScopes.insert(inheritedScopes.begin(), inherScope);
+        // Takes a frame for the constructor, and gives it back with its values released when this returns.
+        auto n_params = layout->constructor ? layout->constructor->param_names.size() : 0;
+        auto depth = constructors_running++;
+        if (constructor_frames.size() <= depth) {
+            constructor_frames.emplace_back();
         }
+        if (constructor_frames[depth].size() < n_params) {
+            constructor_frames[depth].resize(n_params);
+        }
+        // Only the outer vector can grow while this runs, and that doesn't move the symbols.
+        auto frame = constructor_frames[depth].data();
 
-        newInstance->ownScope.setParent(inheritedScopes[0]);
+        struct FrameRelease {
+            Interpreter& inter;
+            Symbol* frame;
+            size_t n_params;
+            ~FrameRelease() {
+                for (size_t i = 0; i < n_params; i++) frame[i].value = nullptr;
+                inter.constructors_running--;
+            }
+        } release{*this, frame, n_params};
 
-        for (auto i = (long)inheritedBody.size()-1; i >= 0; i--) {
-            auto prev = currentScope;
+        // The arguments are evaluated where the instance is made, and bound straight into the frame.
+        for (size_t i = 0; i < node->params.size(); i++) {
+            auto newValue = visit(node->params[i]);
+            if (i >= n_params) continue;
 
-            currentScope = inheritedScopes[i];
-            visit(inheritedBody[i]);
+            if (newValue->is_copyable()) {
+                newValue = newValue->copy();
+            }
 
-            currentScope = prev;
+            auto& param = frame[i];
+            param.name = layout->constructor->param_names[i];
+            param.tp = layout->constructor->param_types[i];
+            if (param.tp && param.tp->name == ANY_TP) {
+                param.tp = newValue->type;
+            }
+            param.value = std::move(newValue);
         }
 
-        auto initID = Lexing::Token {Lexing::ID, "constructor"};
-        auto initFuncCall = ConstructorCallNode::create(initID);
-
-        visit(initFuncCall);
+        for (auto i = node->params.size(); i < n_params; i++) {
+            frame[i].name = layout->constructor->param_names[i];
+            frame[i].tp = layout->constructor->param_types[i];
+        }
 
-        currentScope = tempScope;
+        // Each class in the chain declares its members in its own scope, which only sees
+        // the names it declares and the ones it inherits.
+        for (size_t i = 0; i < layout->levels.size(); i++) {
+            init_members(newInstance, layout->levels[i], &newInstance->levels[i]);
+        }
 
-        newInstance->important = false;
+        if (layout->constructor) {
+            construct(*layout->constructor, frame, node->params.size(), &newInstance->levels[layout->constructor->level]);
+        }
 
         return newInstance;
     }
@@ -2390,33 +3123,20 @@ namespace Odo::Interpreting {
             case NodeType::Index:
             {
                 auto as_index_node = Node::as<IndexNode>(mem);
-                auto visited_source = visit(as_index_node->val);
-                auto visited_indx = visit(as_index_node->expr);
-                auto& as_list = Value::as<ListValue>(visited_source)->elements;
-                auto as_int = Value::as<NormalValue>(visited_indx)->as_int();
-
-                auto as_size_t = static_cast<size_t>(as_int);
-                // TODO: Add funcionality of reverse indexing.
-                if (as_int < 0) {
-                    if ((as_list.size() + as_size_t) < 0) {
-                        throw Exceptions::ValueException(
-                                INDX_STR_OB_EXCP,
-                                current_line,
-                                current_col
-                        );
-                    }
-
-                    as_int = as_list.size() + as_size_t;
-                } else {
-                    if (as_size_t > as_list.size()-1) {
-                        throw Exceptions::ValueException(
-                                INDX_STR_OB_EXCP,
-                                current_line,
-                                current_col
-                        );
-                    }
+                if (as_index_node->expr->kind() == NodeType::NoOp) {
+                    // A list type, like the type of the values in map<string, int[]>.
+                    return handle_list_type(getSymbolFromNode(as_index_node->val), 1);
                 }
-                return &as_list[as_int];
+
+                return getIndexSymbol(visit(as_index_node->val), as_index_node);
+            }
+            case NodeType::MapType:
+            {
+                auto as_map_type = Node::as<MapTypeNode>(mem);
+                return globalTable->addMapType(
+                    getSymbolFromNode(as_map_type->key_type),
+                    getSymbolFromNode(as_map_type->value_type)
+                );
             }
             default:
                 break;
@@ -2425,35 +3145,106 @@ namespace Odo::Interpreting {
         return varSym;
     }
 
+    Symbol* Interpreter::getIndexSymbol(const value_t& visited_source, const std::shared_ptr<IndexNode>& node) {
+        if (visited_source->kind() == ValueType::MapVal) {
+            auto visited_key = visit(node->expr);
+            auto found = Value::as<MapValue>(visited_source)->find(visited_key);
+
+            if (!found) {
+                throw Exceptions::ValueException(
+                    MAP_NO_KEY_EXCP + visited_key->to_string() + "'.",
+                    current_line,
+                    current_col
+                );
+            }
+
+            return found;
+        }
+
+        auto visited_indx = visit(node->expr);
+        auto& as_list = Value::as<ListValue>(visited_source)->elements;
+        auto as_int = Value::as<NormalValue>(visited_indx)->as_int();
+
+        auto as_size_t = static_cast<size_t>(as_int);
+        // TODO: Add funcionality of reverse indexing.
+        if (as_int < 0) {
+            if ((as_list.size() + as_size_t) < 0) {
+                throw Exceptions::ValueException(
+                        INDX_STR_OB_EXCP,
+                        current_line,
+                        current_col
+                );
+            }
+
+            as_int = as_list.size() + as_size_t;
+        } else {
+            if (as_size_t > as_list.size()-1) {
+                throw Exceptions::ValueException(
+                        INDX_STR_OB_EXCP,
+                        current_line,
+                        current_col
+                );
+            }
+        }
+        return &as_list[as_int];
+    }
+
     void Interpreter::interpret(std::string code) {
         parser.set_text(std::move(code));
 
         auto root = parser.program();
 
+        modules.clear();
+        modules.preload(root);
         analyzer->visit(root);
 
+        Heap::Use using_heap(*heap);
+        HeapProfile::Attribution attribution(current_line, current_col, call_stack);
         call_stack.push_back({"global", 1, 1});
-        visit(root);
+        try {
+            visit(root);
+        } catch (...) {
+            // Tasks can still look up names in the scopes of the program, which are about to be gone.
+            if (task_pool) task_pool->wait_all();
+            throw;
+        }
+        if (task_pool) task_pool->wait_all();
         call_stack.pop_back();
     }
 
     value_t Interpreter::eval(std::string code) {
+        Heap::Use using_heap(*heap);
+        HeapProfile::Attribution attribution(current_line, current_col, call_stack);
 
         call_stack.push_back({"global", 1, 1});
         parser.set_text(std::move(code));
 
         auto statements = parser.program_content();
 
+        // Modules imported by earlier lines may have been edited since.
+        modules.clear();
+
     //    try{
         currentScope = &replScope;
 
         auto result = null;
         for (const auto& node : statements) {
             analyzer->from_repl(node);
-            result = visit(node);
+            try {
+                result = visit(node);
+            } catch (Exceptions::OdoException&) {
+                // The statement was accepted by the analyzer but never finished running.
+                // Forget whatever it declared on both sides before reporting the error.
+                auto declared = analyzer->forget_repl_declaration(node);
+                if (!declared.empty()) {
+                    replScope.symbols.erase(declared);
+                }
+                currentScope = globalTable.get();
+                throw;
+            }
         }
 
-        currentScope = &globalTable;
+        currentScope = globalTable.get();
     //    }
         call_stack.pop_back();
 
@@ -2469,20 +3260,12 @@ namespace Odo::Interpreting {
     }
 
     value_t Interpreter::interpret_as_module(const std::string &path, const Lexing::Token& name) {
-        bool has_extension = ends_with(path, ".odo");
-
-        std::string full_path = path;
-        if (!has_extension)
-            full_path += ".odo";
+        auto full_path = Parsing::ModuleLoader::full_path(path);
         auto filename = io::get_file_name(full_path, true);
         if (name.tp != Lexing::NOTHING)
             filename = name.value;
 
-        std::string code = io::read_file(full_path);
-        Parsing::Parser pr;
-        pr.set_text(code);
-
-        auto body = pr.program_content();
+        auto body = modules.get(full_path);
 
         auto file_module = ModuleNode::create(
             Lexing::Token(Lexing::STR, filename),
@@ -0,0 +1,138 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#include "Interpreter/TaskPool.h"
+
+#include <algorithm>
+
+namespace Odo::Interpreting {
+    namespace {
+        // The pool and queue that the current thread works for, if any.
+        thread_local TaskPool* current_pool = nullptr;
+        thread_local size_t current_queue = 0;
+    }
+
+    TaskPool::TaskPool(unsigned int n_threads_) {
+        n_threads = n_threads_ ? n_threads_ : std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int i = 0; i < n_threads; i++) {
+            queues.push_back(std::make_unique<queue>());
+        }
+    }
+
+    TaskPool::~TaskPool() {
+        wait_all();
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    void TaskPool::submit(job j) {
+        std::call_once(started, [this] {
+            for (size_t i = 0; i < n_threads; i++) {
+                threads.emplace_back(&TaskPool::work, this, i);
+            }
+        });
+
+        auto index = current_pool == this
+            ? current_queue
+            : next_queue.fetch_add(1, std::memory_order_relaxed) % n_threads;
+
+        {
+            // Counted before it's pushed, so taking it can never bring the counts below zero.
+            // Taken so the increment can't land between a sleeping thread's check and its wait.
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            queued++;
+            unfinished++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->jobs.push_back(std::move(j));
+        }
+        wake.notify_one();
+    }
+
+    bool TaskPool::run_pending() {
+        job j;
+        auto index = current_pool == this ? current_queue : 0;
+        if (!take(index, j) && !steal(index, j)) {
+            return false;
+        }
+
+        run(j);
+        return true;
+    }
+
+    void TaskPool::wait_all() {
+        while (unfinished > 0) {
+            if (run_pending()) continue;
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] { return unfinished == 0 || queued > 0; });
+        }
+    }
+
+    void TaskPool::run(job& j) {
+        j();
+        j = nullptr;
+
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        if (--unfinished == 0) {
+            wake.notify_all();
+        }
+    }
+
+    bool TaskPool::take(size_t index, job& out) {
+        auto& q = *queues[index];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.jobs.empty()) return false;
+
+        out = std::move(q.jobs.back());
+        q.jobs.pop_back();
+        queued--;
+        return true;
+    }
+
+    bool TaskPool::steal(size_t thief, job& out) {
+        for (size_t i = 1; i < n_threads; i++) {
+            auto& q = *queues[(thief + i) % n_threads];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.jobs.empty()) continue;
+
+            out = std::move(q.jobs.front());
+            q.jobs.pop_front();
+            queued--;
+            return true;
+        }
+
+        return false;
+    }
+
+    void TaskPool::work(size_t index) {
+        current_pool = this;
+        current_queue = index;
+
+        while (true) {
+            job j;
+            if (take(index, j) || steal(index, j)) {
+                run(j);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0) {
+                break;
+            }
+        }
+    }
+}
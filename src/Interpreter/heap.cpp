@@ -0,0 +1,444 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#include "Interpreter/heap.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <unordered_map>
+
+namespace Odo::Interpreting {
+    namespace {
+        // Calls fn with every tracked kind of value that value owns a reference to.
+        // `this` in an instance doesn't own it, so it's skipped. Methods own their instance.
+        template<typename Fn>
+        void for_each_child(Value& value, Fn&& fn) {
+            auto visit = [&](const std::shared_ptr<Value>& child) {
+                if (child && child.use_count() != 0) fn(child.get());
+            };
+            auto visit_scope = [&](SymbolTable& scope) {
+                for (auto& [_, symbol] : scope.symbols) visit(symbol.value);
+            };
+
+            switch (value.kind()) {
+                case ValueType::ListVal:
+                    for (auto& element : static_cast<ListValue&>(value).elements) visit(element.value);
+                    break;
+                case ValueType::MapVal:
+                    for (auto& e : static_cast<MapValue&>(value).entries) visit(e.value.value);
+                    break;
+                case ValueType::ClassVal:
+                    visit_scope(static_cast<ClassValue&>(value).ownScope);
+                    break;
+                case ValueType::InstanceVal: {
+                    auto& instance = static_cast<InstanceValue&>(value);
+                    for (auto& slot : instance.slots) visit(slot.value);
+                    for (auto& level : instance.levels) visit_scope(level);
+                    visit_scope(instance.ownScope);
+                    if (instance.molde) fn(instance.molde.get());
+                    break;
+                }
+                case ValueType::FunctionVal:
+                    visit(static_cast<FunctionValue&>(value).instance);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Drops every reference value owns, so the cycles it's in are broken.
+        void clear(Value& value) {
+            auto clear_scope = [](SymbolTable& scope) {
+                for (auto& [_, symbol] : scope.symbols) symbol.value = nullptr;
+            };
+
+            switch (value.kind()) {
+                case ValueType::ListVal:
+                    static_cast<ListValue&>(value).elements.clear();
+                    break;
+                case ValueType::MapVal:
+                    static_cast<MapValue&>(value).clear();
+                    break;
+                case ValueType::ClassVal:
+                    clear_scope(static_cast<ClassValue&>(value).ownScope);
+                    break;
+                case ValueType::InstanceVal: {
+                    auto& instance = static_cast<InstanceValue&>(value);
+                    for (size_t i = 0; i < instance.slots.size(); i++) {
+                        if (i != ClassLayout::this_slot) instance.slots[i].value = nullptr;
+                    }
+                    for (auto& level : instance.levels) clear_scope(level);
+                    clear_scope(instance.ownScope);
+                    break;
+                }
+                case ValueType::FunctionVal:
+                    static_cast<FunctionValue&>(value).instance = nullptr;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // About how much memory value takes by itself, not counting the values it holds.
+        size_t footprint(Value& value) {
+            switch (value.kind()) {
+                case ValueType::NormalVal: {
+                    // Strings backed by a file share its memory, so only the ones of their own are counted.
+                    auto as_string = std::any_cast<std::string>(&static_cast<NormalValue&>(value).val);
+                    return sizeof(NormalValue) + (as_string ? as_string->capacity() : 0);
+                }
+                case ValueType::ListVal:
+                    return sizeof(ListValue) + static_cast<ListValue&>(value).elements.capacity() * sizeof(Symbol);
+                case ValueType::MapVal:
+                    // Plus the slots, which are between two and four times as many as the entries.
+                    return sizeof(MapValue) + static_cast<MapValue&>(value).entries.capacity() * (sizeof(MapValue::entry) + 3 * sizeof(uint32_t));
+                case ValueType::MatrixVal:
+                    return sizeof(MatrixValue) + static_cast<MatrixValue&>(value).data.capacity() * sizeof(double);
+                case ValueType::FileVal:
+                    return sizeof(FileValue);
+                case ValueType::FunctionVal:
+                    return sizeof(FunctionValue);
+                case ValueType::ModuleVal:
+                    return sizeof(ModuleValue) + static_cast<ModuleValue&>(value).ownScope.symbols.size() * sizeof(Symbol);
+                case ValueType::ClassVal:
+                    return sizeof(ClassValue) + static_cast<ClassValue&>(value).ownScope.symbols.size() * sizeof(Symbol);
+                case ValueType::InstanceVal: {
+                    auto& instance = static_cast<InstanceValue&>(value);
+                    return sizeof(InstanceValue) + instance.slots.capacity() * sizeof(Symbol) + instance.levels.capacity() * sizeof(SymbolTable);
+                }
+                case ValueType::EnumVal:
+                    return sizeof(EnumValue) + static_cast<EnumValue&>(value).ownScope.symbols.size() * sizeof(Symbol);
+                case ValueType::EnumVarVal:
+                    return sizeof(EnumVarValue);
+                case ValueType::NativeFunctionVal:
+                    return sizeof(NativeFunctionValue);
+            }
+
+            return sizeof(Value);
+        }
+
+        void prune(std::vector<std::weak_ptr<Value>>& values) {
+            std::erase_if(values, [](const std::weak_ptr<Value>& value) { return value.expired(); });
+        }
+    }
+
+    namespace {
+        thread_local Heap* current_heap = nullptr;
+    }
+
+    Heap::Use::Use(Heap& heap_)
+        : heap(heap_)
+        , previous(current_heap)
+    {
+        if (previous != &heap) {
+            std::lock_guard<std::mutex> lock(heap.mutex);
+            heap.users++;
+        }
+        current_heap = &heap;
+    }
+
+    Heap::Use::~Use() {
+        if (previous != &heap) {
+            std::lock_guard<std::mutex> lock(heap.mutex);
+            heap.users--;
+        }
+        current_heap = previous;
+    }
+
+    Heap* Heap::current() {
+        return current_heap;
+    }
+
+    void Heap::track(const std::shared_ptr<Value>& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        young.emplace_back(value);
+
+        // Values made by other threads, or in a single long statement, can pile up before
+        // the next collection. Most of them are gone by then, and only hold on to their memory from here.
+        if (young.size() >= prune_at) {
+            prune(young);
+            prune_at = std::max(young_limit * 2, young.size() * 2);
+        }
+
+        young_size.store(young.size(), std::memory_order_relaxed);
+    }
+
+    size_t Heap::collect(bool full) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (users > 1) return 0;
+
+        full = full || old.size() >= old_limit;
+
+        std::vector<std::shared_ptr<Value>> values;
+        auto take = [&](std::vector<std::weak_ptr<Value>>& from) {
+            for (auto& weak : from) {
+                if (auto value = weak.lock()) values.push_back(std::move(value));
+            }
+            from.clear();
+        };
+
+        take(young);
+        if (full) take(old);
+        young_size.store(0, std::memory_order_relaxed);
+        prune_at = young_limit * 2;
+
+        std::unordered_map<Value*, size_t> positions;
+        positions.reserve(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            positions[values[i].get()] = i;
+        }
+
+        auto each_tracked_child = [&](size_t i, auto&& fn) {
+            for_each_child(*values[i], [&](Value* child) {
+                auto found = positions.find(child);
+                if (found != positions.end()) fn(found->second);
+            });
+        };
+
+        // The references that don't come from another value in this collection. The one in values doesn't count.
+        std::vector<long> outside(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            outside[i] = values[i].use_count() - 1;
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            each_tracked_child(i, [&](size_t child) { outside[child]--; });
+        }
+
+        std::vector<bool> reachable(values.size(), false);
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (outside[i] > 0) {
+                reachable[i] = true;
+                pending.push_back(i);
+            }
+        }
+
+        while (!pending.empty()) {
+            auto i = pending.back();
+            pending.pop_back();
+            each_tracked_child(i, [&](size_t child) {
+                if (!reachable[child]) {
+                    reachable[child] = true;
+                    pending.push_back(child);
+                }
+            });
+        }
+
+        // Everything in the garbage is held here until it's all been emptied, so none of it is freed halfway through.
+        std::vector<std::shared_ptr<Value>> garbage;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (reachable[i]) {
+                old.emplace_back(values[i]);
+            } else {
+                garbage.push_back(std::move(values[i]));
+            }
+        }
+        values.clear();
+
+        for (auto& value : garbage) {
+            totals.reclaimed_bytes += footprint(*value);
+            clear(*value);
+        }
+
+        totals.collections++;
+        totals.reclaimed_objects += garbage.size();
+        if (full) {
+            totals.full_collections++;
+            old_limit = std::max(young_limit * 4, old.size() * 2);
+        }
+
+        auto reclaimed = garbage.size();
+        garbage.clear();
+
+        return reclaimed;
+    }
+
+    Heap::Stats Heap::stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto result = totals;
+        for (auto* values : {&young, &old}) {
+            for (auto& weak : *values) {
+                if (auto value = weak.lock()) result.live[value->kind()]++;
+            }
+        }
+
+        return result;
+    }
+
+    namespace {
+        // What values made on this thread are attributed to.
+        thread_local const HeapProfile::Attribution* attributed = nullptr;
+
+        // Where values were made. They're never removed, so they're referred to by their position.
+        struct Site {
+            std::string frame;
+            unsigned int line;
+            unsigned int col;
+        };
+
+        struct Allocation {
+            std::weak_ptr<Value> value;
+            size_t site;
+        };
+
+        struct Usage {
+            size_t bytes{0};
+            size_t count{0};
+
+            void add(size_t size) {
+                bytes += size;
+                count++;
+            }
+        };
+
+        struct Profile {
+            std::mutex mutex;
+            std::vector<Site> sites;
+            // The sites at each line and column, told apart by their function.
+            std::unordered_map<uint64_t, std::vector<size_t>> sites_at;
+            std::unordered_map<const Value*, Allocation> live;
+
+            size_t site_of(unsigned int line, unsigned int col, const std::string& frame) {
+                auto& candidates = sites_at[(uint64_t)line << 32 | col];
+                for (auto site : candidates) {
+                    if (sites[site].frame == frame) return site;
+                }
+
+                sites.push_back({frame, line, col});
+                candidates.push_back(sites.size() - 1);
+                return sites.size() - 1;
+            }
+        };
+
+        // Never destroyed, since values can still be freed while the program exits.
+        Profile& profile() {
+            static auto* instance = new Profile();
+            return *instance;
+        }
+
+        std::string kind_name(ValueType kind) {
+            switch (kind) {
+                case ValueType::NormalVal: return NORMAL_KIND_MSG;
+                case ValueType::ListVal: return LIST_KIND_MSG;
+                case ValueType::MapVal: return MAP_KIND_MSG;
+                case ValueType::MatrixVal: return MATRIX_KIND_MSG;
+                case ValueType::FileVal: return FILE_KIND_MSG;
+                case ValueType::FunctionVal: return FUNCTION_KIND_MSG;
+                case ValueType::ModuleVal: return MODULE_KIND_MSG;
+                case ValueType::ClassVal: return CLASS_KIND_MSG;
+                case ValueType::InstanceVal: return INSTANCE_KIND_MSG;
+                case ValueType::EnumVal: return ENUM_KIND_MSG;
+                case ValueType::EnumVarVal: return ENUM_VAR_KIND_MSG;
+                case ValueType::NativeFunctionVal: return NATIVE_FUNCTION_KIND_MSG;
+            }
+
+            return "";
+        }
+
+        std::string site_name(const Site& site) {
+            if (site.line == 0 && site.frame.empty()) return HEAP_PROFILE_NO_SITE_MSG;
+
+            return MSG_LINE_TXT " " + std::to_string(site.line) + ", " MSG_COL_TXT " " + std::to_string(site.col) + HEAP_PROFILE_IN_MSG + site.frame;
+        }
+
+        // Writes a row for each name, with the ones that take the most memory first.
+        void write_usage(std::ostream& out, std::vector<std::pair<std::string, Usage>> rows) {
+            std::stable_sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+                return a.second.bytes > b.second.bytes;
+            });
+
+            out << std::setw(14) << HEAP_PROFILE_BYTES_COL_MSG << std::setw(12) << HEAP_PROFILE_COUNT_COL_MSG << "\n";
+            for (auto& [name, usage] : rows) {
+                if (usage.count == 0) continue;
+                out << std::setw(14) << usage.bytes << std::setw(12) << usage.count << "  " << name << "\n";
+            }
+        }
+    }
+
+    HeapProfile::Attribution::Attribution(const unsigned int& line_, const unsigned int& col_, const std::vector<Frame>& call_stack_)
+        : line(line_)
+        , col(col_)
+        , call_stack(call_stack_)
+    {
+        if (!on) return;
+
+        previous = attributed;
+        attributed = this;
+    }
+
+    HeapProfile::Attribution::~Attribution() {
+        if (attributed == this) attributed = previous;
+    }
+
+    void HeapProfile::record(const std::shared_ptr<Value>& value) {
+        unsigned int line = 0;
+        unsigned int col = 0;
+        static const std::string no_frame;
+        const std::string* frame = &no_frame;
+        if (attributed) {
+            line = attributed->line;
+            col = attributed->col;
+            if (!attributed->call_stack.empty()) frame = &attributed->call_stack.back().name;
+        }
+
+        auto& p = profile();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        p.live[value.get()] = {value, p.site_of(line, col, *frame)};
+    }
+
+    void HeapProfile::forget(const Value* value) {
+        auto& p = profile();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        p.live.erase(value);
+    }
+
+    void HeapProfile::report(std::ostream& out) {
+        if (!on) {
+            out << HEAP_PROFILE_OFF_MSG << "\n";
+            return;
+        }
+
+        // The values are held while they're measured, and let go of once the profile isn't locked,
+        // since that could be what frees them.
+        std::vector<std::pair<std::shared_ptr<Value>, size_t>> values;
+        std::vector<Site> sites;
+        {
+            auto& p = profile();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            values.reserve(p.live.size());
+            for (auto& [_, allocation] : p.live) {
+                if (auto value = allocation.value.lock()) values.emplace_back(std::move(value), allocation.site);
+            }
+            sites = p.sites;
+        }
+
+        Usage total;
+        std::map<ValueType, Usage> by_kind;
+        std::vector<Usage> by_site(sites.size());
+        for (auto& [value, site] : values) {
+            auto bytes = footprint(*value);
+            total.add(bytes);
+            by_kind[value->kind()].add(bytes);
+            by_site[site].add(bytes);
+        }
+        values.clear();
+
+        std::vector<std::pair<std::string, Usage>> kind_rows;
+        for (auto& [kind, usage] : by_kind) {
+            kind_rows.emplace_back(kind_name(kind), usage);
+        }
+
+        std::vector<std::pair<std::string, Usage>> site_rows;
+        for (size_t i = 0; i < sites.size(); i++) {
+            site_rows.emplace_back(site_name(sites[i]), by_site[i]);
+        }
+
+        out << HEAP_PROFILE_TITLE_MSG << total.count << HEAP_PROFILE_VALUES_MSG << total.bytes << HEAP_PROFILE_BYTES_MSG << "\n";
+        out << HEAP_PROFILE_BY_TYPE_MSG << "\n";
+        write_usage(out, std::move(kind_rows));
+        out << HEAP_PROFILE_BY_SITE_MSG << "\n";
+        write_usage(out, std::move(site_rows));
+        out << std::flush;
+    }
+}
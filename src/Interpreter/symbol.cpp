@@ -7,6 +7,7 @@
 #include "Translations/lang.h"
 #include <utility>
 #include <iostream>
+#include <mutex>
 
 namespace Odo::Interpreting {
     SymbolTable::SymbolTable() = default;
@@ -23,26 +24,44 @@ namespace Odo::Interpreting {
         }
     }
 
+    void SymbolTable::share_between_threads() {
+        if (!guard) {
+            guard = std::make_shared<std::shared_mutex>();
+        }
+    }
+
     Symbol *SymbolTable::findSymbol(const std::string& name, bool and_in_parents) {
-        auto foundS = symbols.find(name);
+        {
+            std::shared_lock<std::shared_mutex> lock;
+            if (guard) lock = std::shared_lock<std::shared_mutex>(*guard);
+
+            auto foundS = symbols.find(name);
+            if (foundS != symbols.end()) {
+                return &foundS->second;
+            }
+
+            if (slot_names) {
+                auto in_slots = slot_names->find(name);
+                if (in_slots != slot_names->end()) return slots + in_slots->second;
+            }
 
-        if (foundS == symbols.end()) {
             if (!aliases.empty()) {
                 auto in_aliases = aliases.find(name);
                 if(in_aliases != aliases.end()) return in_aliases->second;
             }
+        }
 
-            if (and_in_parents && parent != nullptr){
-                return parent->findSymbol(name);
-            }
-
-            return nullptr;
-        } else {
-            return &foundS->second;
+        if (and_in_parents && parent != nullptr){
+            return parent->findSymbol(name);
         }
+
+        return nullptr;
     }
 
     Symbol* SymbolTable::addSymbol(const Symbol& sym) {
+        std::unique_lock<std::shared_mutex> lock;
+        if (guard) lock = std::unique_lock<std::shared_mutex>(*guard);
+
         std::string new_sym_name = sym.name;
         auto foundS = symbols.find(new_sym_name);
 
@@ -67,6 +86,10 @@ namespace Odo::Interpreting {
         if (symbolExists(name)) {
             return nullptr;
         }
+
+        std::unique_lock<std::shared_mutex> lock;
+        if (guard) lock = std::unique_lock<std::shared_mutex>(*guard);
+
         aliases.insert({name, sym});
 
         return sym;
@@ -83,6 +106,15 @@ namespace Odo::Interpreting {
     }
 
     void SymbolTable::removeSymbol(Symbol* name) {
+        std::unique_lock<std::shared_mutex> lock;
+        if (guard) lock = std::unique_lock<std::shared_mutex>(*guard);
+
+        auto by_name = symbols.find(name->name);
+        if (by_name != symbols.end() && &by_name->second == name) {
+            symbols.erase(by_name);
+            return;
+        }
+
         for (auto it = symbols.begin(); it != symbols.end(); it++) {
             if (&it->second == name) {
                 symbols.erase(it);
@@ -92,6 +124,9 @@ namespace Odo::Interpreting {
     }
 
     Symbol* SymbolTable::addListType(Symbol* tp) {
+        std::unique_lock<std::shared_mutex> lock;
+        if (guard) lock = std::unique_lock<std::shared_mutex>(*guard);
+
         std::string new_sym_name = tp->name+"[]";
         auto foundAsListType = symbols.find(new_sym_name);
         if (foundAsListType != symbols.end())
@@ -117,10 +152,34 @@ namespace Odo::Interpreting {
         return added;
     }
 
+    Symbol* SymbolTable::addMapType(Symbol* key, Symbol* value) {
+        std::unique_lock<std::shared_mutex> lock;
+        if (guard) lock = std::unique_lock<std::shared_mutex>(*guard);
+
+        std::string new_sym_name = std::string(MAP_TP) + "<" + key->name + ", " + value->name + ">";
+        auto found = symbols.find(new_sym_name);
+        if (found != symbols.end())
+            return &found->second;
+
+        symbols[new_sym_name] = Symbol{
+            .tp=value,
+            .name=new_sym_name,
+            .isType=true,
+            .kind=SymbolType::MapType,
+            .key_tp=key
+        };
+
+        return &symbols.find(new_sym_name)->second;
+    }
+
     bool SymbolTable::symbolExists(const std::string& name) {
+        std::shared_lock<std::shared_mutex> lock;
+        if (guard) lock = std::shared_lock<std::shared_mutex>(*guard);
+
         auto in_symbols = symbols.find(name);
 
         if (in_symbols != symbols.end()) return true;
+        if (slot_names && slot_names->find(name) != slot_names->end()) return true;
         return aliases.find(name) != aliases.end();
     }
 
@@ -131,6 +190,9 @@ namespace Odo::Interpreting {
     }
 
     Symbol *SymbolTable::addFuncType(Symbol *type, const std::string& funcName) {
+        std::unique_lock<std::shared_mutex> lock;
+        if (guard) lock = std::unique_lock<std::shared_mutex>(*guard);
+
         auto foundAsFuncType = symbols.find(funcName);
         if (foundAsFuncType != symbols.end())
             return &foundAsFuncType->second;
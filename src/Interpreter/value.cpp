@@ -3,20 +3,41 @@
 ////
 
 #include "Interpreter/value.h"
+#include "Interpreter/heap.h"
 #include "utils.h"
 #include <utility>
 #include <vector>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <Interpreter/Interpreter.h>
 #include "Translations/lang.h"
 
 namespace Odo::Interpreting {
+    namespace {
+        // Every value is made through here, so the heap profile sees all of them.
+        template<typename T, typename... Args>
+        std::shared_ptr<T> make_value(Args&&... args) {
+            auto value = std::make_shared<T>(std::forward<Args>(args)...);
+            if (HeapProfile::enabled()) HeapProfile::record(value);
+            return value;
+        }
+
+        // Values that can hold others go to the heap of the interpreter making them.
+        void track(const std::shared_ptr<Value>& value) {
+            if (auto heap = Heap::current()) heap->track(value);
+        }
+    }
+
+    Value::~Value() {
+        if (HeapProfile::enabled()) HeapProfile::forget(this);
+    }
 
     NormalValue::NormalValue(Symbol *tp, std::any the_value) : Value(tp), val(std::move(the_value)) {}
 
     std::shared_ptr<Value> NormalValue::copy() {
-        auto copied_value = std::make_shared<NormalValue>(type, val);
+        auto copied_value = make_value<NormalValue>(type, val);
 
         return copied_value;
     }
@@ -34,46 +55,91 @@ namespace Odo::Interpreting {
     }
 
     std::string NormalValue::as_string() {
-        return std::any_cast<std::string>(val);
+        return std::string(as_string_view());
     }
 
-    std::string NormalValue::to_string() {
-        std::string result;
-        if (type->name == DOUBLE_TP) {
-            auto this_as_double = as_double();
+    std::string_view NormalValue::as_string_view() {
+        if (auto text = std::any_cast<std::string>(&val)) {
+            return *text;
+        }
 
-            int floored = static_cast<int>(floor(this_as_double));
-            if (this_as_double - floored < 1e-15) {
-                result = std::to_string(floored) + ".0";
-            } else {
-                std::stringstream double_parsed;
-                double_parsed << std::setprecision(std::numeric_limits<double>::digits10) << this_as_double;
+        return std::any_cast<const mapped_text&>(val)->view();
+    }
 
-                result = double_parsed.str();
-                result.erase ( result.find_last_not_of('0') + 1, std::string::npos );
-                if (result.find('.') == std::string::npos){
-                    result += ".0";
-                }
+    std::string& NormalValue::own_string() {
+        if (auto text = std::any_cast<std::string>(&val)) {
+            return *text;
+        }
+
+        val = as_string();
+        return std::any_cast<std::string&>(val);
+    }
+
+    std::any NormalValue::primitive() {
+        if (val.type() == typeid(mapped_text)) {
+            return as_string();
+        }
+
+        return val;
+    }
+
+    namespace {
+        void render_int(Sink& out, int value) {
+            char buffer[16];
+            auto result = std::to_chars(buffer, buffer + sizeof buffer, value);
+            out.write({buffer, static_cast<size_t>(result.ptr - buffer)});
+        }
+
+        void render_double(Sink& out, double value) {
+            auto floored = floor(value);
+            if (value - floored < 1e-15
+                && floored >= std::numeric_limits<int>::min()
+                && floored <= std::numeric_limits<int>::max()) {
+                render_int(out, static_cast<int>(floored));
+                out.write(".0");
+                return;
             }
+
+            // Same as printing with a precision of digits10, without building a stream.
+            char buffer[32];
+            auto result = std::to_chars(
+                buffer, buffer + sizeof buffer, value,
+                std::chars_format::general, std::numeric_limits<double>::digits10
+            );
+            std::string_view formatted(buffer, result.ptr - buffer);
+            out.write(formatted);
+
+            if (formatted.find_first_of(".e") == std::string_view::npos) {
+                out.write(".0");
+            }
+        }
+    }
+
+    std::string NormalValue::to_string() {
+        std::string result;
+        Sink sink(result);
+        render(sink);
+        return result;
+    }
+
+    void NormalValue::render(Sink& out) {
+        if (type->name == DOUBLE_TP) {
+            render_double(out, as_double());
         } else if (type->name == INT_TP){
-            auto this_as_int = as_int();
-            result = std::to_string(this_as_int);
+            render_int(out, as_int());
         } else if (type->name == STRING_TP){
-            result = as_string();
+            out.write(as_string_view());
         } else if (type->name == BOOL_TP){
-            auto this_as_bool = as_bool();
-            result = this_as_bool ? TRUE_TK : FALSE_TK;
+            out.write(as_bool() ? TRUE_TK : FALSE_TK);
         } else if (type->name == NULL_TP){
-            result = NULL_TK;
+            out.write(NULL_TK);
         } else {
-            result = CORRUPTED_MSG;
+            out.write(CORRUPTED_MSG);
         }
-
-        return result;
     }
 
     std::shared_ptr<NormalValue> NormalValue::create(Symbol *tp, std::any the_value) {
-        return std::make_shared<NormalValue>(tp, the_value);
+        return make_value<NormalValue>(tp, the_value);
     }
 
     ListValue::ListValue(Symbol* tp, std::vector<Symbol> sym_elements)
@@ -81,45 +147,51 @@ namespace Odo::Interpreting {
         , elements(std::move(sym_elements)) {}
 
     std::shared_ptr<ListValue> ListValue::create(Symbol* tp, std::vector<Symbol> sym_elements) {
-        return std::make_shared<ListValue>(tp, sym_elements);
+        auto value = make_value<ListValue>(tp, std::move(sym_elements));
+        track(value);
+        return value;
     }
 
     std::shared_ptr<Value> ListValue::copy() {
         // Copy elements first.
-
-        auto val_els = as_list_value();
         std::vector<Symbol> symbols_copied;
-        for (const auto& value_in_val : val_els) {
-            auto list_el = value_in_val;
-            if (value_in_val->is_copyable()) {
+        symbols_copied.reserve(elements.size());
+        for (const auto& element : elements) {
+            auto list_el = element.value;
+            if (list_el->is_copyable()) {
                 list_el = list_el->copy();
             }
 
-            symbols_copied.push_back({value_in_val->type, "list_element", list_el});
-
-            auto& new_sym = *(symbols_copied.end()-1);
-            new_sym.value = list_el;
+            symbols_copied.push_back({list_el->type, "list_element", std::move(list_el)});
         }
 
-        auto copied_value = std::make_shared<ListValue>(type, std::move(symbols_copied));
-
-        return copied_value;
+        return create(type, std::move(symbols_copied));
     }
 
     std::string ListValue::to_string() {
-        std::string result = "[";
-        auto values_in_v = as_list_value();
-        for (auto myValIter = values_in_v.begin(); myValIter < values_in_v.end(); myValIter++) {
-            auto myVal = *myValIter;
-            result += myVal ? myVal->to_string() : CORRUPTED_MSG;
-
-            if (myValIter != values_in_v.end() - 1) {
-                result += ", ";
+        std::string result;
+        // A guess of a few characters per element, so short elements fit without growing it.
+        result.reserve(2 + elements.size() * 4);
+        Sink sink(result);
+        render(sink);
+        return result;
+    }
+
+    void ListValue::render(Sink& out) {
+        out.write("[");
+        for (size_t i = 0; i < elements.size(); i++) {
+            if (i > 0) {
+                out.write(", ");
             }
-        }
-        result += "]";
 
-        return result;
+            auto& value = elements[i].value;
+            if (value) {
+                value->render(out);
+            } else {
+                out.write(CORRUPTED_MSG);
+            }
+        }
+        out.write("]");
     }
 
     std::vector<std::shared_ptr<Value> > ListValue::as_list_value() {
@@ -132,6 +204,224 @@ namespace Odo::Interpreting {
         return results;
     }
 
+    namespace {
+        size_t mix(uint64_t x) {
+            // The finalizer of splitmix64, so keys that are close together land far apart.
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return static_cast<size_t>(x);
+        }
+
+        size_t hash_key(Value& key) {
+            auto& normal = static_cast<NormalValue&>(key);
+            auto& name = key.type->name;
+
+            if (name == INT_TP) {
+                return mix(static_cast<uint64_t>(normal.as_int()));
+            } else if (name == STRING_TP) {
+                return std::hash<std::string_view>{}(normal.as_string_view());
+            } else if (name == DOUBLE_TP) {
+                auto value = normal.as_double();
+                // 0.0 and -0.0 are the same key, and so is every NaN.
+                if (value == 0) return mix(0);
+                if (std::isnan(value)) return mix(0x7ff8000000000000ULL);
+
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof bits);
+                return mix(bits);
+            } else {
+                return mix(normal.as_bool());
+            }
+        }
+
+        bool same_key(Value& a, Value& b) {
+            if (a.type != b.type) return false;
+
+            auto& left = static_cast<NormalValue&>(a);
+            auto& right = static_cast<NormalValue&>(b);
+            auto& name = a.type->name;
+
+            if (name == INT_TP) {
+                return left.as_int() == right.as_int();
+            } else if (name == STRING_TP) {
+                return left.as_string_view() == right.as_string_view();
+            } else if (name == DOUBLE_TP) {
+                auto x = left.as_double();
+                auto y = right.as_double();
+                return x == y || (std::isnan(x) && std::isnan(y));
+            } else {
+                return left.as_bool() == right.as_bool();
+            }
+        }
+    }
+
+    MapValue::MapValue(Symbol* tp): Value(tp) {}
+
+    std::shared_ptr<MapValue> MapValue::create(Symbol* tp) {
+        auto value = make_value<MapValue>(tp);
+        track(value);
+        return value;
+    }
+
+    std::shared_ptr<Value> MapValue::copy() {
+        auto copied_value = create(type);
+        copied_value->entries.reserve(entries.size());
+        for (const auto& e : entries) {
+            auto value = e.value.value;
+            if (value->is_copyable()) {
+                value = value->copy();
+            }
+
+            // Keys are never changed, so both maps can hold the same ones.
+            copied_value->entries.push_back({e.hash, e.key, {value->type, "map_value", std::move(value)}});
+        }
+        copied_value->slots = slots;
+
+        return copied_value;
+    }
+
+    size_t MapValue::find_slot(size_t hash, Value& key) {
+        auto mask = slots.size() - 1;
+        for (auto i = hash & mask;; i = (i + 1) & mask) {
+            auto position = slots[i];
+            if (position == 0) return i;
+
+            auto& e = entries[position - 1];
+            if (e.hash == hash && same_key(*e.key, key)) return i;
+        }
+    }
+
+    void MapValue::grow() {
+        slots.assign(std::max<size_t>(8, slots.size() * 2), 0);
+
+        auto mask = slots.size() - 1;
+        for (size_t position = 0; position < entries.size(); position++) {
+            auto i = entries[position].hash & mask;
+            while (slots[i] != 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = static_cast<uint32_t>(position + 1);
+        }
+    }
+
+    Symbol* MapValue::find(const std::shared_ptr<Value>& key) {
+        if (entries.empty()) return nullptr;
+
+        auto position = slots[find_slot(hash_key(*key), *key)];
+        return position ? &entries[position - 1].value : nullptr;
+    }
+
+    void MapValue::set(std::shared_ptr<Value> key, std::shared_ptr<Value> value) {
+        auto hash = hash_key(*key);
+
+        if (!slots.empty()) {
+            auto position = slots[find_slot(hash, *key)];
+            if (position != 0) {
+                entries[position - 1].value.value = std::move(value);
+                return;
+            }
+        }
+
+        // Kept at most half full, so the probes stay short.
+        if ((entries.size() + 1) * 2 > slots.size()) {
+            grow();
+        }
+
+        auto slot = find_slot(hash, *key);
+
+        auto value_type = value->type;
+        entries.push_back({hash, std::move(key), {value_type, "map_value", std::move(value)}});
+        slots[slot] = static_cast<uint32_t>(entries.size());
+    }
+
+    void MapValue::clear() {
+        entries.clear();
+        slots.clear();
+    }
+
+    std::string MapValue::to_string() {
+        std::string result;
+        result.reserve(2 + entries.size() * 8);
+        Sink sink(result);
+        render(sink);
+        return result;
+    }
+
+    void MapValue::render(Sink& out) {
+        out.write("{");
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (i > 0) {
+                out.write(", ");
+            }
+
+            entries[i].key->render(out);
+            out.write(": ");
+
+            auto& value = entries[i].value.value;
+            if (value) {
+                value->render(out);
+            } else {
+                out.write(CORRUPTED_MSG);
+            }
+        }
+        out.write("}");
+    }
+
+    MatrixValue::MatrixValue(Symbol* tp, size_t rows_, size_t cols_, std::vector<double> data_)
+        : Value(tp)
+        , rows(rows_)
+        , cols(cols_)
+        , data(std::move(data_)) {}
+
+    std::shared_ptr<MatrixValue> MatrixValue::create(Symbol* tp, size_t rows_, size_t cols_, std::vector<double> data_) {
+        return make_value<MatrixValue>(tp, rows_, cols_, std::move(data_));
+    }
+
+    std::shared_ptr<MatrixValue> MatrixValue::create(Symbol* tp, size_t rows_, size_t cols_) {
+        return create(tp, rows_, cols_, std::vector<double>(rows_ * cols_, 0.0));
+    }
+
+    std::shared_ptr<Value> MatrixValue::copy() {
+        return create(type, rows, cols, data);
+    }
+
+    std::string MatrixValue::to_string() {
+        std::string result;
+        Sink sink(result);
+        render(sink);
+        return result;
+    }
+
+    void MatrixValue::render(Sink& out) {
+        out.write("[");
+        for (size_t row = 0; row < rows; row++) {
+            out.write(row > 0 ? ", [" : "[");
+            for (size_t col = 0; col < cols; col++) {
+                if (col > 0) {
+                    out.write(", ");
+                }
+                render_double(out, at(row, col));
+            }
+            out.write("]");
+        }
+        out.write("]");
+    }
+
+    FileValue::FileValue(Symbol* tp, std::shared_ptr<io::File> file_)
+        : Value(tp)
+        , file(std::move(file_)) {}
+
+    std::shared_ptr<FileValue> FileValue::create(Symbol* tp, std::shared_ptr<io::File> file_) {
+        return make_value<FileValue>(tp, std::move(file_));
+    }
+
+    std::shared_ptr<Value> FileValue::copy() {
+        return create(type, file);
+    }
+
     FunctionValue::FunctionValue(Symbol* tp, std::vector<std::shared_ptr<Parsing::Node>> params_, std::shared_ptr<Parsing::Node> body_, SymbolTable* scope_, std::string name_)
         : Value(tp)
         , params(std::move(params_))
@@ -141,12 +431,12 @@ namespace Odo::Interpreting {
 
 
     std::shared_ptr<FunctionValue> FunctionValue::create(Symbol* tp, std::vector<std::shared_ptr<Parsing::Node>> params_, std::shared_ptr<Parsing::Node> body_, SymbolTable* scope_, std::string name) {
-        return std::make_shared<FunctionValue>(tp, params_, body_, scope_, name=ANONYMUS_MSG);
+        return make_value<FunctionValue>(tp, params_, body_, scope_, std::move(name));
     }
 
     std::shared_ptr<Value> FunctionValue::copy() {
         // This shouldn't be called ever...
-        auto copied_value = std::make_shared<FunctionValue>(type, params, body, parentScope, name);
+        auto copied_value = make_value<FunctionValue>(type, params, body, parentScope, name);
 
         return copied_value;
     }
@@ -157,12 +447,12 @@ namespace Odo::Interpreting {
 
 
     std::shared_ptr<ModuleValue> ModuleValue::create(Symbol* tp, const SymbolTable& scope) {
-        return std::make_shared<ModuleValue>(tp, scope);
+        return make_value<ModuleValue>(tp, scope);
     }
 
     std::shared_ptr<Value> ModuleValue::copy() {
         // This shouldn't be called ever...
-        auto copied_value = std::make_shared<ModuleValue>(type, ownScope);
+        auto copied_value = make_value<ModuleValue>(type, ownScope);
 
         return copied_value;
     }
@@ -174,14 +464,14 @@ namespace Odo::Interpreting {
         , parentScope(parent_) {}
 
     std::shared_ptr<ClassValue> ClassValue::create(Symbol* tp, const SymbolTable& scope, SymbolTable* parent_, std::shared_ptr<Parsing::Node> body_) {
-        return std::make_shared<ClassValue>(tp, scope, parent_, body_);
+        auto value = make_value<ClassValue>(tp, scope, parent_, body_);
+        track(value);
+        return value;
     }
 
     std::shared_ptr<Value> ClassValue::copy() {
         // This shouldn't be called ever...
-        auto copied_value = std::make_shared<ClassValue>(type, ownScope, parentScope, body);
-
-        return copied_value;
+        return create(type, ownScope, parentScope, body);
     }
 
     Symbol* ClassValue::getStaticVarSymbol(const std::string& name) {
@@ -199,18 +489,53 @@ namespace Odo::Interpreting {
         return nullptr;
     }
 
-    InstanceValue::InstanceValue(Symbol* tp, std::shared_ptr<ClassValue> molde_, const SymbolTable& scope)
+    InstanceValue::InstanceValue(Symbol* tp, std::shared_ptr<ClassValue> molde_, std::shared_ptr<const ClassLayout> layout_)
         : Value(tp)
         , molde(std::move(molde_))
-        , ownScope(scope) {}
+        , layout(std::move(layout_))
+        , slots(layout->slot_names.size())
+    {
+        for (size_t i = 0; i < slots.size(); i++) {
+            slots[i].name = layout->slot_names[i];
+        }
 
-    std::shared_ptr<InstanceValue> InstanceValue::create(Symbol* tp, std::shared_ptr<ClassValue> molde_, const SymbolTable& scope) {
-        return std::make_shared<InstanceValue>(tp, molde_, scope);
+        auto& self = slots[ClassLayout::this_slot];
+        self.tp = tp;
+        self.value = std::shared_ptr<Value>(std::shared_ptr<Value>(), this);
+
+        levels.reserve(layout->levels.size());
+        auto parent = molde->parentScope;
+        for (auto& level : layout->levels) {
+            auto& scope = levels.emplace_back("inherited-scope", std::unordered_map<std::string, Symbol>{}, parent);
+            scope.setSlots(&level.names, slots.data());
+            parent = &scope;
+        }
+
+        ownScope.setSlots(&layout->names, slots.data());
+        ownScope.setParent(parent);
+    }
+
+    std::shared_ptr<Value> InstanceValue::owned(const std::shared_ptr<Value>& value) {
+        // Only `this` is a pointer to something that doesn't count as one of its owners.
+        if (value && value.use_count() == 0) {
+            return std::static_pointer_cast<InstanceValue>(value)->shared_from_this();
+        }
+
+        return value;
+    }
+
+    std::shared_ptr<InstanceValue> InstanceValue::create(Symbol* tp, std::shared_ptr<ClassValue> molde_, std::shared_ptr<const ClassLayout> layout_) {
+        auto value = make_value<InstanceValue>(tp, std::move(molde_), std::move(layout_));
+        track(value);
+        return value;
     }
 
     std::shared_ptr<Value> InstanceValue::copy() {
         // This shouldn't be called ever...
-        auto copied_value = std::make_shared<InstanceValue>(type, molde, ownScope);
+        auto copied_value = create(type, molde, layout);
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (i != ClassLayout::this_slot) copied_value->slots[i] = slots[i];
+        }
 
         return copied_value;
     }
@@ -222,12 +547,12 @@ namespace Odo::Interpreting {
     EnumValue::EnumValue(Symbol* tp, const SymbolTable& scope): Value(tp), ownScope(scope) {}
 
     std::shared_ptr<EnumValue> EnumValue::create(Symbol* tp, const SymbolTable& scope) {
-        return std::make_shared<EnumValue>(tp, scope);
+        return make_value<EnumValue>(tp, scope);
     }
 
     std::shared_ptr<Value> EnumValue::copy() {
         // This shouldn't be called ever...
-        auto copied_value = std::make_shared<EnumValue>(type, ownScope);
+        auto copied_value = make_value<EnumValue>(type, ownScope);
 
         return copied_value;
     }
@@ -235,18 +560,18 @@ namespace Odo::Interpreting {
     EnumVarValue::EnumVarValue(Symbol* tp, std::string name_): Value(tp), name(std::move(name_)) {}
 
     std::shared_ptr<EnumVarValue> EnumVarValue::create(Symbol* tp, std::string name_) {
-        return std::make_shared<EnumVarValue>(tp, name_);
+        return make_value<EnumVarValue>(tp, name_);
     }
 
     std::shared_ptr<Value> EnumVarValue::copy() {
         // This shouldn't be called ever...
-        auto copied_value = std::make_shared<EnumVarValue>(type, name);
+        auto copied_value = make_value<EnumVarValue>(type, name);
 
         return copied_value;
     }
 
     std::shared_ptr<Value> NativeFunctionValue::copy() {
-        auto copied_value = std::make_shared<NativeFunctionValue>(type, arguments, fn);
+        auto copied_value = make_value<NativeFunctionValue>(type, arguments, fn);
         return copied_value;
     }
 
@@ -257,10 +582,10 @@ namespace Odo::Interpreting {
         : Value(tp), values_fn(std::move(fn_)), arguments(std::move(args)), function_kind(NativeFunctionType::Values) {}
 
     std::shared_ptr<NativeFunctionValue> NativeFunctionValue::create(Symbol* tp, const std::vector<std::pair<Symbol*, bool>>& args, const simple_primitives_function_type& fn_) {
-        return std::make_shared<NativeFunctionValue>(tp, args, std::move(fn_));
+        return make_value<NativeFunctionValue>(tp, args, std::move(fn_));
     }
 
     std::shared_ptr<NativeFunctionValue> NativeFunctionValue::create(Symbol* tp, const std::vector<std::pair<Symbol*, bool>>& args, const handle_values_function_type& fn_) {
-        return std::make_shared<NativeFunctionValue>(tp, args, fn_);
+        return make_value<NativeFunctionValue>(tp, args, fn_);
     }
 }
\ No newline at end of file
@@ -29,6 +29,7 @@ namespace Odo::Lexing {
             {FOR_TK, Token(FOR, FOR_TK)},
             {FOREACH_TK, Token(FOREACH, FOREACH_TK)},
             {FORANGE_TK, Token(FORANGE, FORANGE_TK)},
+            {PARALLEL_TK, Token(PARALLEL, PARALLEL_TK)},
             {WHILE_TK, Token(WHILE, WHILE_TK)},
             {LOOP_TK, Token(LOOP, LOOP_TK)},
             {BREAK_TK, Token(BREAK, BREAK_TK)},
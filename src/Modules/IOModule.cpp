@@ -5,5 +5,49 @@
 #include "Modules/IOModule.h"
 
 namespace Odo::Modules {
+    std::shared_ptr<io::File> IOModule::open_file(const std::string& path, const std::string& mode) {
+        io::File::Mode file_mode;
+        if (mode == FILE_READ_MODE) {
+            file_mode = io::File::Mode::Read;
+        } else if (mode == FILE_WRITE_MODE) {
+            file_mode = io::File::Mode::Write;
+        } else if (mode == FILE_APPEND_MODE) {
+            file_mode = io::File::Mode::Append;
+        } else {
+            throw Exceptions::ValueException(FILE_MODE_EXCP + mode + "'.");
+        }
 
-}
\ No newline at end of file
+        try {
+            return std::make_shared<io::File>(path, file_mode);
+        } catch (Exceptions::IOException&) {
+            if (file_mode == io::File::Mode::Read) {
+                throw Exceptions::FileException(COULD_NOT_READ_EXCP + path + MAY_NOT_EXIST_EXCP);
+            }
+            throw Exceptions::FileException(COULD_NOT_WRITE_EXCP + path + FOL_MAY_NOT_EXIST_EXCP);
+        }
+    }
+
+    io::File& IOModule::file_of(const Interpreting::value_t& value, bool reading, bool writing) {
+        auto& file = *Interpreting::Value::as<Interpreting::FileValue>(value)->file;
+        if (!file.is_open()) {
+            throw Exceptions::FileException(FILE_CLOSED_EXCP + file.path() + "'.");
+        }
+
+        auto is_read = file.mode() == io::File::Mode::Read;
+        if (reading && !is_read) {
+            throw Exceptions::FileException(FILE_NOT_READABLE_EXCP + file.path() + "'.");
+        }
+        if (writing && is_read) {
+            throw Exceptions::FileException(FILE_NOT_WRITABLE_EXCP + file.path() + "'.");
+        }
+
+        return file;
+    }
+
+    void IOModule::failed(const io::File& file, bool reading) {
+        if (reading) {
+            throw Exceptions::FileException(COULD_NOT_READ_EXCP + file.path() + MAY_NOT_EXIST_EXCP);
+        }
+        throw Exceptions::FileException(COULD_NOT_WRITE_EXCP + file.path() + FOL_MAY_NOT_EXIST_EXCP);
+    }
+}
@@ -0,0 +1,117 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#include "Modules/MatrixModule.h"
+#include "Modules/kernel.h"
+
+#include <algorithm>
+
+namespace Odo::Modules::matrix_kernels {
+    // Sizes of the tiles, in elements. A tile of each of a, b and out, 64 x 64 doubles,
+    // fits in a typical L2 cache together.
+    constexpr size_t block = 64;
+    constexpr size_t transpose_block = 32;
+
+    // Goes through tiles so the rows of b it reads are still in cache for the next rows of a.
+    // The innermost loop runs along a row of b and of out, so it's contiguous and gets vectorized.
+    ODO_KERNEL void matmul(const double* a, const double* b, double* out, size_t n, size_t m, size_t p) {
+        for (size_t i0 = 0; i0 < n; i0 += block) {
+            auto i_end = std::min(i0 + block, n);
+            for (size_t k0 = 0; k0 < m; k0 += block) {
+                auto k_end = std::min(k0 + block, m);
+                for (size_t j0 = 0; j0 < p; j0 += block) {
+                    auto j_end = std::min(j0 + block, p);
+
+                    for (size_t i = i0; i < i_end; i++) {
+                        auto out_row = out + i * p;
+                        for (size_t k = k0; k < k_end; k++) {
+                            auto a_ik = a[i * m + k];
+                            auto b_row = b + k * p;
+                            for (size_t j = j0; j < j_end; j++) {
+                                out_row[j] += a_ik * b_row[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Works on square tiles, so both the reads and the writes stay within a few cache lines.
+    ODO_KERNEL void transpose(const double* a, double* out, size_t rows, size_t cols) {
+        for (size_t r0 = 0; r0 < rows; r0 += transpose_block) {
+            auto r_end = std::min(r0 + transpose_block, rows);
+            for (size_t c0 = 0; c0 < cols; c0 += transpose_block) {
+                auto c_end = std::min(c0 + transpose_block, cols);
+                for (size_t r = r0; r < r_end; r++) {
+                    for (size_t c = c0; c < c_end; c++) {
+                        out[c * rows + r] = a[r * cols + c];
+                    }
+                }
+            }
+        }
+    }
+
+    ODO_KERNEL void sub(const double* x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = x[i] - y[i];
+    }
+}
+
+namespace Odo::Modules {
+    size_t MatrixModule::read_size(const Interpreting::value_t& value) {
+        auto size = read_int(value);
+        if (size < 0) {
+            throw Exceptions::ValueException(MATRIX_NEGATIVE_SIZE_EXCP);
+        }
+
+        return (size_t)size;
+    }
+
+    void MatrixModule::same_shape(const matrix_t& a, const matrix_t& b) {
+        if (a->rows != b->rows || a->cols != b->cols) {
+            throw Exceptions::ValueException(
+                MATRIX_SHAPES_EXCP + shape_of(a) + MATRIX_AND_EXCP + shape_of(b) + "."
+            );
+        }
+    }
+
+    void MatrixModule::check_index(const matrix_t& m, int row, int col) {
+        if (row < 0 || col < 0 || (size_t)row >= m->rows || (size_t)col >= m->cols) {
+            throw Exceptions::ValueException(
+                MATRIX_INDEX_EXCP + std::to_string(row) + ", " + std::to_string(col) + MATRIX_IN_EXCP + shape_of(m) + "."
+            );
+        }
+    }
+
+    void MatrixModule::check_matmul(const matrix_t& a, const matrix_t& b) {
+        if (a->cols != b->rows) {
+            throw Exceptions::ValueException(
+                MATRIX_MATMUL_EXCP + shape_of(a) + MATRIX_AND_EXCP + shape_of(b) + "."
+            );
+        }
+    }
+
+    MatrixModule::matrix_t MatrixModule::from_list(const Interpreting::value_t& value) {
+        auto& rows = Interpreting::Value::as<Interpreting::ListValue>(value)->elements;
+        size_t cols = 0;
+        if (!rows.empty()) {
+            cols = Interpreting::Value::as<Interpreting::ListValue>(rows[0].value)->elements.size();
+        }
+
+        std::vector<double> data;
+        data.reserve(rows.size() * cols);
+        for (auto& row : rows) {
+            auto& elements = Interpreting::Value::as<Interpreting::ListValue>(row.value)->elements;
+            if (elements.size() != cols) {
+                throw Exceptions::ValueException(MATRIX_RAGGED_EXCP);
+            }
+
+            for (auto& element : elements) {
+                data.push_back(read_number(element.value));
+            }
+        }
+
+        return Interpreting::MatrixValue::create(matrix_type, rows.size(), cols, std::move(data));
+    }
+}
@@ -13,10 +13,11 @@ namespace Odo::Modules {
         : ModuleValue(nullptr, {name, {}, &inter.get_global()})
         , analyzer(inter.get_analyzer())
     {
-        int_type = &inter.get_global().symbols[INT_TP];
-        double_type = &inter.get_global().symbols[DOUBLE_TP];
-        bool_type = &inter.get_global().symbols[BOOL_TP];
-        string_type = &inter.get_global().symbols[STRING_TP];
+        int_type = inter.get_global().findSymbol(INT_TP);
+        double_type = inter.get_global().findSymbol(DOUBLE_TP);
+        bool_type = inter.get_global().findSymbol(BOOL_TP);
+        string_type = inter.get_global().findSymbol(STRING_TP);
+        any_type = inter.get_global().findSymbol(ANY_TP);
     }
 
     void NativeModule::add_literal(const std::string& name, const std::string& value) {
@@ -76,4 +77,30 @@ namespace Odo::Modules {
         function_symbol->value = func_value;
         function_symbol->is_initialized = true;
     }
-}
\ No newline at end of file
+
+    void NativeModule::add_values_function(
+        const std::string &name,
+        const std::vector<std::pair<Interpreting::Symbol *, bool>> &arg_types,
+        Interpreting::Symbol *ret, Interpreting::handle_values_function_type callback,
+        std::function<Semantics::NodeResult(const std::shared_ptr<Parsing::FuncCallNode>&)> check
+    )
+    {
+        auto function_type = ownScope.addFuncType(ret, arg_types);
+
+        auto function_symbol = ownScope.addSymbol({
+            .tp=function_type,
+            .name=name,
+            .kind=Interpreting::SymbolType::FunctionSymbol
+        });
+
+        auto func_value = Interpreting::NativeFunctionValue::create(function_type, arg_types, std::move(callback));
+        function_symbol->value = func_value;
+        function_symbol->is_initialized = true;
+
+        auto an = analyzer.lock();
+        an->get_function_context_map().insert({function_type, arg_types});
+        if (check) {
+            an->add_call_check(func_value.get(), std::move(check));
+        }
+    }
+}
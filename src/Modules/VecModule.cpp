@@ -0,0 +1,132 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#include "Modules/VecModule.h"
+#include "Modules/kernel.h"
+
+namespace Odo::Modules::vec_kernels {
+    // The reductions keep four partial results, so the additions don't wait on each other
+    // and the compiler can put them in one vector register. Floating point additions can't be
+    // reordered on their own, so it wouldn't do it with a single accumulator.
+    template<typename T, typename Acc>
+    static inline Acc sum_of(const T* x, size_t n) {
+        Acc a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            a0 += x[i];
+            a1 += x[i + 1];
+            a2 += x[i + 2];
+            a3 += x[i + 3];
+        }
+        for (; i < n; i++) a0 += x[i];
+
+        return (a0 + a1) + (a2 + a3);
+    }
+
+    template<typename T, typename Acc>
+    static inline Acc dot_of(const T* x, const T* y, size_t n) {
+        Acc a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            a0 += (Acc)x[i] * y[i];
+            a1 += (Acc)x[i + 1] * y[i + 1];
+            a2 += (Acc)x[i + 2] * y[i + 2];
+            a3 += (Acc)x[i + 3] * y[i + 3];
+        }
+        for (; i < n; i++) a0 += (Acc)x[i] * y[i];
+
+        return (a0 + a1) + (a2 + a3);
+    }
+
+    template<typename T, typename Before>
+    static inline size_t position_of(const T* x, size_t n, Before before) {
+        size_t best = 0;
+        for (size_t i = 1; i < n; i++) {
+            if (before(x[i], x[best])) best = i;
+        }
+
+        return best;
+    }
+
+    ODO_KERNEL double sum(const double* x, size_t n) { return sum_of<double, double>(x, n); }
+    ODO_KERNEL long long sum(const int* x, size_t n) { return sum_of<int, long long>(x, n); }
+
+    ODO_KERNEL double dot(const double* x, const double* y, size_t n) { return dot_of<double, double>(x, y, n); }
+    ODO_KERNEL long long dot(const int* x, const int* y, size_t n) { return dot_of<int, long long>(x, y, n); }
+
+    ODO_KERNEL void axpy(double a, const double* x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = a * x[i] + y[i];
+    }
+
+    ODO_KERNEL void axpy(int a, const int* x, const int* y, int* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = a * x[i] + y[i];
+    }
+
+    ODO_KERNEL void scale(double a, const double* x, double* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = a * x[i];
+    }
+
+    ODO_KERNEL void scale(int a, const int* x, int* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = a * x[i];
+    }
+
+    ODO_KERNEL void add(const double* x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = x[i] + y[i];
+    }
+
+    ODO_KERNEL void add(const int* x, const int* y, int* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = x[i] + y[i];
+    }
+
+    ODO_KERNEL void mul(const double* x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = x[i] * y[i];
+    }
+
+    ODO_KERNEL void mul(const int* x, const int* y, int* out, size_t n) {
+        for (size_t i = 0; i < n; i++) out[i] = x[i] * y[i];
+    }
+
+    // A NaN never comes before anything, so it's only picked when it's the first element.
+    ODO_KERNEL size_t argmin(const double* x, size_t n) { return position_of(x, n, [](double a, double b){ return a < b; }); }
+    ODO_KERNEL size_t argmin(const int* x, size_t n) { return position_of(x, n, [](int a, int b){ return a < b; }); }
+    ODO_KERNEL size_t argmax(const double* x, size_t n) { return position_of(x, n, [](double a, double b){ return a > b; }); }
+    ODO_KERNEL size_t argmax(const int* x, size_t n) { return position_of(x, n, [](int a, int b){ return a > b; }); }
+}
+
+namespace Odo::Modules {
+    void VecModule::same_length(const std::vector<Interpreting::value_t>& lists) {
+        auto n = Interpreting::Value::as<Interpreting::ListValue>(lists[0])->elements.size();
+        for (auto& list : lists) {
+            if (Interpreting::Value::as<Interpreting::ListValue>(list)->elements.size() != n) {
+                throw Exceptions::ValueException(VEC_LENGTHS_EXCP);
+            }
+        }
+    }
+
+    void VecModule::not_empty(const Interpreting::value_t& list, const std::string& name) {
+        if (Interpreting::Value::as<Interpreting::ListValue>(list)->elements.empty()) {
+            throw Exceptions::ValueException(VEC_EMPTY_EXCP + name + "'.");
+        }
+    }
+
+    Interpreting::value_t VecModule::map_native(const Interpreting::value_t& list, const Interpreting::value_t& function_value) {
+        auto function = std::dynamic_pointer_cast<Interpreting::NativeFunctionValue>(function_value);
+        if (!function || function->function_kind != Interpreting::NativeFunctionValue::NativeFunctionType::Simple) {
+            throw Exceptions::FunctionCallException(VEC_MAP_NATIVE_EXCP);
+        }
+
+        auto x = gather<double>(list);
+        if (function->type->tp == int_type) {
+            std::vector<int> out;
+            out.reserve(x.size());
+            for (auto value : x) out.push_back(std::any_cast<int>(function->fn({value})));
+            return list_of(out);
+        }
+
+        std::vector<double> out;
+        out.reserve(x.size());
+        for (auto value : x) out.push_back(std::any_cast<double>(function->fn({value})));
+        return list_of(out);
+    }
+}
@@ -0,0 +1,11 @@
+
+#include "Parser/AST/MapExpressionNode.h"
+
+namespace Odo::Parsing {
+
+MapExpressionNode::MapExpressionNode(std::vector<std::shared_ptr<Parsing::Node>> keys_p, std::vector<std::shared_ptr<Parsing::Node>> values_p)
+    : keys(std::move(keys_p))
+    , values(std::move(values_p)){}
+
+}
+
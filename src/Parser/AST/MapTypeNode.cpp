@@ -0,0 +1,11 @@
+
+#include "Parser/AST/MapTypeNode.h"
+
+namespace Odo::Parsing {
+
+MapTypeNode::MapTypeNode(std::shared_ptr<Parsing::Node> key_type_p, std::shared_ptr<Parsing::Node> value_type_p)
+    : key_type(std::move(key_type_p))
+    , value_type(std::move(value_type_p)){}
+
+}
+
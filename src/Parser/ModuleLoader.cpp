@@ -0,0 +1,112 @@
+//
+// Created by Luis Gonzalez on 10/19/26.
+//
+
+#include "Parser/ModuleLoader.h"
+#include "Parser/parser.h"
+#include "IO/io.h"
+#include "utils.h"
+
+#include "Parser/AST/BlockNode.h"
+#include "Parser/AST/ModuleNode.h"
+#include "Parser/AST/ImportNode.h"
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+namespace Odo::Parsing {
+    std::string ModuleLoader::full_path(const std::string& path) {
+        if (ends_with(path, ".odo"))
+            return path;
+        return path + ".odo";
+    }
+
+    ModuleLoader::parsed_module ModuleLoader::parse(const std::string& full_path) {
+        parsed_module result;
+        try {
+            Parser pr;
+            pr.set_text(io::read_file(full_path));
+            result.body = pr.program_content();
+        } catch (...) {
+            result.error = std::current_exception();
+        }
+        return result;
+    }
+
+    void ModuleLoader::collect_imports(const std::vector<std::shared_ptr<Node>>& statements, std::vector<std::string>& found) {
+        for (const auto& st : statements) {
+            switch (st->kind()) {
+                case NodeType::Import:
+                    found.push_back(full_path(Node::as<ImportNode>(st)->path.value));
+                    break;
+                case NodeType::Module:
+                    collect_imports(Node::as<ModuleNode>(st)->statements, found);
+                    break;
+                case NodeType::Block:
+                    collect_imports(Node::as<BlockNode>(st)->statements, found);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void ModuleLoader::preload(const std::shared_ptr<Node>& program) {
+        std::vector<std::string> pending;
+        collect_imports({program}, pending);
+
+        auto max_workers = std::max(1u, std::thread::hardware_concurrency());
+
+        while (!pending.empty()) {
+            // Every module in this level is independent of the others, as none of them
+            // has been looked at yet. Their own imports make up the next level.
+            std::vector<std::string> level;
+            for (auto& path : pending) {
+                if (modules.find(path) == modules.end() &&
+                    std::find(level.begin(), level.end(), path) == level.end()) {
+                    level.push_back(std::move(path));
+                }
+            }
+            pending.clear();
+
+            for (size_t start = 0; start < level.size(); start += max_workers) {
+                auto end = std::min(level.size(), start + max_workers);
+
+                std::vector<std::future<parsed_module>> jobs;
+                jobs.reserve(end - start);
+                for (size_t i = start; i < end; i++) {
+                    jobs.push_back(std::async(std::launch::async, parse, level[i]));
+                }
+
+                for (size_t i = start; i < end; i++) {
+                    auto parsed = jobs[i - start].get();
+                    if (!parsed.error) {
+                        collect_imports(parsed.body, pending);
+                    }
+                    modules.emplace(level[i], std::move(parsed));
+                }
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Node>> ModuleLoader::get(const std::string& full_path) {
+        auto found = modules.find(full_path);
+        if (found == modules.end()) {
+            found = modules.emplace(full_path, parse(full_path)).first;
+        }
+
+        if (found->second.error) {
+            // Don't keep failures around, the file may exist by the next time it's imported.
+            auto error = found->second.error;
+            modules.erase(found);
+            std::rethrow_exception(error);
+        }
+
+        return found->second.body;
+    }
+
+    void ModuleLoader::clear() {
+        modules.clear();
+    }
+}
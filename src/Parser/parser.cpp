@@ -53,6 +53,8 @@
 #include "Parser/AST/MemberVarNode.h"
 #include "Parser/AST/StaticVarNode.h"
 #include "Parser/AST/IndexNode.h"
+#include "Parser/AST/MapTypeNode.h"
+#include "Parser/AST/MapExpressionNode.h"
 
 namespace Odo::Parsing{
     using namespace Lexing;
@@ -222,6 +224,15 @@ namespace Odo::Parsing{
                 eat(FORANGE);
                 ex = forangestatement();
                 break;
+            case PARALLEL:
+            {
+                eat(PARALLEL);
+                eat(FORANGE);
+                auto as_forange = Node::as<FoRangeNode>(forangestatement());
+                as_forange->parallel = true;
+                ex = as_forange;
+                break;
+            }
             case WHILE:
                 eat(WHILE);
                 ex = whilestatement();
@@ -304,8 +315,25 @@ namespace Odo::Parsing{
 //        }
 
         if (current_token.tp == ID) {
-            tp = VariableNode::create(current_token);
+            auto name = current_token;
             eat(ID);
+
+            if (name.value == MAP_TP && current_token.tp == LT) {
+                // map<key_type, value_type>
+                auto ln = line();
+                auto cl = column();
+                eat(LT);
+                auto key_type = get_full_type();
+                eat(COMMA);
+                auto value_type = get_full_type();
+                eat(GT);
+
+                tp = MapTypeNode::create(key_type, value_type);
+                tp->line_number = ln;
+                tp->column_number = cl;
+            } else {
+                tp = VariableNode::create(name);
+            }
         }
 
         while (current_token.tp == DCOLON) {
@@ -572,6 +600,16 @@ namespace Odo::Parsing{
         eat(ID);
         ignore_nl();
 
+        // foreach key, value : a_map
+        Lexing::Token value_var(NOTHING, "");
+        if (current_token.tp == COMMA) {
+            eat(COMMA);
+            ignore_nl();
+            value_var = current_token;
+            eat(ID);
+            ignore_nl();
+        }
+
         Lexing::Token reverse_token(NOTHING, "");
         if (current_token.tp == REV) {
             eat(REV);
@@ -594,6 +632,7 @@ namespace Odo::Parsing{
         body = statement(false);
 
         auto result = ForEachNode::create(std::move(var), std::move(lst_expression), body, std::move(reverse_token));
+        Node::as<ForEachNode>(result)->value_var = std::move(value_var);
 
         result->line_number = ln;
         result->column_number = cl;
@@ -1384,6 +1423,35 @@ namespace Odo::Parsing{
                 auto list_expr = ListExpressionNode::create(contents);
                 return list_expr;
             }
+            case LCUR:
+            {
+                // A map literal, like {"a": 1, "b": 2}
+                auto ln = line();
+                auto cl = column();
+                eat(LCUR);
+                ignore_nl();
+
+                std::vector<std::shared_ptr<Node>> keys;
+                std::vector<std::shared_ptr<Node>> values;
+                while (current_token.tp != RCUR) {
+                    keys.push_back(ternary_op());
+                    eat(COLON);
+                    ignore_nl();
+                    values.push_back(ternary_op());
+                    ignore_nl();
+
+                    if (current_token.tp != RCUR) {
+                        eat(COMMA);
+                        ignore_nl();
+                    }
+                }
+
+                eat(RCUR);
+                auto map_expr = MapExpressionNode::create(keys, values);
+                map_expr->line_number = ln;
+                map_expr->column_number = cl;
+                return map_expr;
+            }
             case NULLT:
             {
                 auto null_ret = NullNode::create();
@@ -15,13 +15,13 @@ namespace Odo::Semantics {
     using namespace Parsing;
     // This should initialize the symbol tables and basic types, like the Interpreter.
     SemanticAnalyzer::SemanticAnalyzer(Interpreting::Interpreter& inter_): inter(inter_) {
-        currentScope = &inter.globalTable;
-        globalScope = {"global-semantics-context", {}, &inter.globalTable};
+        currentScope = inter.globalTable.get();
+        globalScope = {"global-semantics-context", {}, inter.globalTable.get()};
 
-        type_int = &inter.globalTable.symbols[INT_TP];
-        type_double = &inter.globalTable.symbols[DOUBLE_TP];
-        type_string = &inter.globalTable.symbols[STRING_TP];
-        type_bool = &inter.globalTable.symbols[BOOL_TP];
+        type_int = inter.globalTable->findSymbol(INT_TP);
+        type_double = inter.globalTable->findSymbol(DOUBLE_TP);
+        type_string = inter.globalTable->findSymbol(STRING_TP);
+        type_bool = inter.globalTable->findSymbol(BOOL_TP);
 
         replScope = { "repl-analyzer", {}, &globalScope };
 
@@ -42,11 +42,16 @@ namespace Odo::Semantics {
         native_function_data[READ_FN] = {type_string};
         native_function_data[READ_INT_FN] = {type_int};
         native_function_data[READ_DOUBLE_FN] = {type_double};
+        native_function_data[READ_ALL_INTS_FN] = {handle_list_type(type_int)};
+        native_function_data[READ_LINES_FN] = {handle_list_type(type_string)};
         native_function_data[RAND_FN] = {type_double};
         native_function_data[RAND_INT_FN] = {type_int};
         native_function_data[POP_FN] = {inter.any_type()};
         native_function_data[PUSH_FN] = {};
         native_function_data[TYPEOF_FN] = {type_string};
+        native_function_data[SORT_FN] = {};
+        native_function_data[BINARY_SEARCH_FN] = {type_int};
+        native_function_data[REVERSE_FN] = {};
 
         native_function_data[TO_ABS_PATH_FN] = {type_string};
         native_function_data[GET_CWD_FN] = {type_string};
@@ -152,6 +157,12 @@ namespace Odo::Semantics {
         }
     }
 
+    void SemanticAnalyzer::drop_lazy(Interpreting::Symbol* sym) {
+        for (auto& scope : lazy_scope_stack) {
+            scope.erase(sym);
+        }
+    }
+
     Interpreting::SymbolTable* SemanticAnalyzer::add_semantic_context(Interpreting::Symbol* sym, std::string name) {
         return add_semantic_context(sym, {std::move(name), {}, currentScope});
     }
@@ -195,7 +206,14 @@ namespace Odo::Semantics {
             return false;
         }
 
+        if (type1->kind == Interpreting::SymbolType::MapType
+         || type2->kind == Interpreting::SymbolType::MapType) {
+            if (type1->kind == type2->kind) {
+                return type1->key_tp == type2->key_tp && counts_as(type1->tp, type2->tp);
+            }
 
+            return false;
+        }
 
         auto curr = type1;
         while (curr) {
@@ -230,7 +248,7 @@ namespace Odo::Semantics {
         if (dimensions == 0) return sym;
 
         do {
-            tp = inter.globalTable.addListType(prev_sym);
+            tp = inter.globalTable->addListType(prev_sym);
     
             auto element_template_name = "__$" + tp->name + "_list_element";
 
@@ -251,6 +269,36 @@ namespace Odo::Semantics {
         return tp;
     }
 
+    // The values a map knows how to hash.
+    static bool is_map_key_type(Interpreting::Symbol* tp) {
+        auto& name = tp->name;
+        return name == INT_TP || name == DOUBLE_TP || name == STRING_TP || name == BOOL_TP;
+    }
+
+    Interpreting::Symbol* SemanticAnalyzer::handle_map_type(Interpreting::Symbol* key, Interpreting::Symbol* value, const std::shared_ptr<Parsing::Node>& node) {
+        if (!is_map_key_type(key) && key != inter.any_type()) {
+            throw Exceptions::TypeException(
+                MAP_KEY_TYPE_EXCP + key->name + ".",
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        auto tp = inter.globalTable->addMapType(key, value);
+
+        auto value_template_name = "__$" + tp->name + "_map_value";
+        if (!currentScope->findSymbol(value_template_name)) {
+            auto map_value = currentScope->addSymbol({
+                value,
+                value_template_name
+            });
+
+            map_value->is_initialized = true;
+        }
+
+        return tp;
+    }
+
     Interpreting::Symbol* SemanticAnalyzer::getStaticFromClass(Interpreting::Symbol* cls, const std::shared_ptr<Parsing::StaticVarNode>& var) {
         auto current_class = cls;
         do {
@@ -325,6 +373,13 @@ namespace Odo::Semantics {
                     if (leftHandSym->kind == Interpreting::SymbolType::ModuleSymbol) {
                         auto module_context = get_semantic_context(leftHandSym);
                         varSym = module_context->findSymbol(as_static_var->name.value, false);
+
+                        // The context of a native module is a copy of its scope, but the values it makes
+                        // have the types of the original, so those are the ones to compare against.
+                        auto as_native_module = std::dynamic_pointer_cast<Modules::NativeModule>(leftHandSym->value);
+                        if (varSym && varSym->isType && as_native_module) {
+                            varSym = as_native_module->ownScope.findSymbol(as_static_var->name.value, false);
+                        }
                     } else if (leftHandSym->kind == Interpreting::SymbolType::ClassType) {
                         varSym = getStaticFromClass(leftHandSym, as_static_var);
                     } else if (leftHandSym->kind == Interpreting::SymbolType::EnumType) {
@@ -362,6 +417,11 @@ namespace Odo::Semantics {
             case NodeType::Index:
             {
                 auto as_index_node = Node::as<IndexNode>(mem);
+                if (as_index_node->expr->kind() == NodeType::NoOp) {
+                    // A list type, like the type of the values in map<string, int[]>.
+                    return handle_list_type(getSymbolFromNode(as_index_node->val));
+                }
+
                 auto visited_source = visit(as_index_node->val);
 
                 if (!visited_source.type) {
@@ -396,6 +456,11 @@ namespace Odo::Semantics {
                                 as_index_node->column_number
                         );
                     }
+                } else if (visited_source.type->kind == Interpreting::SymbolType::MapType) {
+                    check_map_key(visited_source.type, visit(as_index_node->expr), as_index_node);
+
+                    auto map_type = handle_map_type(visited_source.type->key_tp, visited_source.type->tp, as_index_node);
+                    varSym = currentScope->findSymbol("__$" + map_type->name + "_map_value");
                 } else {
                     throw Exceptions::ValueException(
                             ASS_TO_INVALID_INDX_EXCP,
@@ -405,6 +470,22 @@ namespace Odo::Semantics {
                 }
                 break;
             }
+            case NodeType::MapType:
+            {
+                auto as_map_type = Node::as<MapTypeNode>(mem);
+                auto key_type = getSymbolFromNode(as_map_type->key_type);
+                auto value_type = getSymbolFromNode(as_map_type->value_type);
+
+                if (!(key_type && key_type->isType && value_type && value_type->isType)) {
+                    throw Exceptions::TypeException(
+                            INVALID_TYPE_EXCP "?'.",
+                            mem->line_number,
+                            mem->column_number
+                    );
+                }
+
+                return handle_map_type(key_type, value_type, mem);
+            }
             default:
                 break;
         }
@@ -489,6 +570,8 @@ namespace Odo::Semantics {
 
             case NodeType::ListExpression:
                  return visit_ListExpression(Node::as<ListExpressionNode>(node));
+            case NodeType::MapExpression:
+                 return visit_MapExpression(Node::as<MapExpressionNode>(node));
 
                 // Functions
             case NodeType::FuncExpression:
@@ -539,6 +622,10 @@ namespace Odo::Semantics {
             case NodeType::Define:
                 return visit_Define(Node::as<DefineNode>(node));
 
+            // Map types are only read as types, through getSymbolFromNode.
+            case NodeType::MapType:
+                return {};
+
             case NodeType::Debug:
                 (void)0;
             case NodeType::Null:
@@ -887,6 +974,14 @@ namespace Odo::Semantics {
             );
         }
 
+        if (node->value_var.tp != Lexing::NOTHING && lst_value.type->kind != Interpreting::SymbolType::MapType) {
+            throw Exceptions::SemanticException(
+                FOREACH_VALUE_ONLY_MAP_EXCP,
+                node->line_number,
+                node->column_number
+            );
+        }
+
         if (lst_value.type->kind == Interpreting::SymbolType::ListType) {
             std::shared_ptr<Node> iterator_decl;
             auto empty_initial = NoOpNode::create();
@@ -900,6 +995,19 @@ namespace Odo::Semantics {
             currentScope->findSymbol(node->var.value)->is_initialized = true;
 
             visit(node->body);
+        } else if (lst_value.type->kind == Interpreting::SymbolType::MapType) {
+            auto key_iter = currentScope->addSymbol({lst_value.type->key_tp, node->var.value});
+            key_iter->is_initialized = true;
+
+            if (node->value_var.tp != Lexing::NOTHING) {
+                auto value_iter = currentScope->addSymbol({lst_value.type->tp, node->value_var.value});
+                value_iter->is_initialized = true;
+            }
+
+            bool prev_state = inside_loop;
+            inside_loop = true;
+            visit(node->body);
+            inside_loop = prev_state;
         } else if (lst_value.type->name == STRING_TP) {
             auto iterator_decl = VarDeclarationNode::create(
                 VariableNode::create(Lexing::Token(Lexing::TokenType::ID, STRING_TP)),
@@ -914,6 +1022,23 @@ namespace Odo::Semantics {
             visit(node->body);
             inside_loop = prev_state;
 
+        } else if (iterable_types.find(lst_value.type) != iterable_types.end()) {
+            // These are read as the loop goes, so there's no end to start from.
+            if (node->rev.tp != Lexing::NOTHING) {
+                throw Exceptions::SemanticException(
+                    FOREACH_ONLY_FORWARD_EXCP,
+                    node->line_number,
+                    node->column_number
+                );
+            }
+
+            auto iter = currentScope->addSymbol({iterable_types[lst_value.type], node->var.value});
+            iter->is_initialized = true;
+
+            bool prev_state = inside_loop;
+            inside_loop = true;
+            visit(node->body);
+            inside_loop = prev_state;
         } else {
             throw Exceptions::ValueException(
                     FOREACH_ONLY_LIST_STR_EXCP,
@@ -968,10 +1093,681 @@ namespace Odo::Semantics {
         visit(node->body);
         inside_loop = prev_state;
 
+        if (node->parallel) {
+            check_parallel_body(node);
+        }
+
         currentScope = forScope.getParent();
         return {};
     }
 
+    namespace {
+        // Splits `a[x][y]` into its source `a` and the index expressions, outermost first.
+        std::shared_ptr<Node> split_index(std::shared_ptr<Node> node, std::vector<std::shared_ptr<Node>>& indices) {
+            while (node->kind() == NodeType::Index) {
+                auto as_index = Node::as<IndexNode>(node);
+                indices.insert(indices.begin(), as_index->expr);
+                node = as_index->val;
+            }
+            return node;
+        }
+
+        template<typename Context>
+        [[noreturn]] void not_parallel(const std::shared_ptr<Node>& node, const Context& ctx, const std::string& reason) {
+            throw Exceptions::SemanticException(
+                ctx.subject + reason,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        bool is_declared(const std::vector<std::set<std::string>>& locals, const std::string& name) {
+            for (const auto& scope : locals) {
+                if (scope.find(name) != scope.end()) return true;
+            }
+            return false;
+        }
+    }
+
+    // Iterations of a parallel forange run at the same time, each one in its own scope.
+    // They can be split that way only if no iteration sees what another one does:
+    // - Variables declared outside of the loop are only read.
+    // - Lists declared outside of the loop can be written through an index, if every use
+    //   of that list has the loop iterator as the index at the same position. Then each
+    //   iteration only touches its own elements.
+    // - Only functions that don't have side effects are called. Native ones are listed
+    //   here, and the bodies of user functions are checked with the same rules.
+    // - Nothing depends on the order of the iterations, like break or return.
+    void SemanticAnalyzer::check_parallel_body(const std::shared_ptr<Parsing::FoRangeNode>& node) {
+        parallel_context ctx;
+        if (node->var.tp != Lexing::NOTHING) {
+            ctx.iterator = node->var.value;
+        }
+        ctx.locals.emplace_back();
+
+        check_parallel_node(node->body, ctx);
+
+        for (const auto& written : ctx.written) {
+            if (ctx.read_by_functions.find(written) != ctx.read_by_functions.end()) {
+                not_parallel(node, ctx, PAR_LIST_IN_FUNC_EXCP + written + "'.");
+            }
+
+            std::set<size_t> common;
+            bool first = true;
+            for (const auto& use : ctx.uses) {
+                if (use.name != written) continue;
+
+                if (use.whole) {
+                    not_parallel(use.node, ctx, PAR_LIST_INDEX_EXCP + written + PAR_BY_ITERATOR_EXCP);
+                }
+
+                if (first) {
+                    common = use.levels;
+                    first = false;
+                } else {
+                    std::set<size_t> still_common;
+                    for (auto level : use.levels) {
+                        if (common.find(level) != common.end()) still_common.insert(level);
+                    }
+                    common = still_common;
+                }
+
+                if (common.empty()) {
+                    not_parallel(use.node, ctx, PAR_LIST_INDEX_EXCP + written + PAR_BY_ITERATOR_EXCP);
+                }
+            }
+        }
+    }
+
+    void SemanticAnalyzer::check_parallel_node(const std::shared_ptr<Parsing::Node>& node, parallel_context& ctx) {
+        if (!node) return;
+
+        auto declare = [&](const std::string& name) {
+            if (!ctx.in_function && name == ctx.iterator) {
+                not_parallel(node, ctx, PAR_REDECLARES_ITER_EXCP + name + "'.");
+            }
+            ctx.locals.back().insert(name);
+        };
+
+        auto check_loop_body = [&](const std::shared_ptr<Node>& body) {
+            ctx.loop_depth++;
+            check_parallel_node(body, ctx);
+            ctx.loop_depth--;
+        };
+
+        switch (node->kind()) {
+            case NodeType::Double:
+            case NodeType::Int:
+            case NodeType::Bool:
+            case NodeType::Str:
+            case NodeType::NoOp:
+            case NodeType::Null:
+            case NodeType::Debug:
+            case NodeType::Continue:
+            case NodeType::StaticVar:
+                break;
+            case NodeType::Break:
+                if (ctx.loop_depth == 0) {
+                    not_parallel(node, ctx, PAR_ORDER_EXCP);
+                }
+                break;
+            case NodeType::Return:
+                if (!ctx.in_function) {
+                    not_parallel(node, ctx, PAR_ORDER_EXCP);
+                }
+                check_parallel_node(Node::as<ReturnNode>(node)->val, ctx);
+                break;
+            case NodeType::BinOp:
+            {
+                auto as_bin_op = Node::as<BinOpNode>(node);
+                check_parallel_node(as_bin_op->left, ctx);
+                check_parallel_node(as_bin_op->right, ctx);
+                break;
+            }
+            case NodeType::UnaryOp:
+                check_parallel_node(Node::as<UnaryOpNode>(node)->ast, ctx);
+                break;
+            case NodeType::TernaryOp:
+            {
+                auto as_ternary = Node::as<TernaryOpNode>(node);
+                check_parallel_node(as_ternary->cond, ctx);
+                check_parallel_node(as_ternary->trueb, ctx);
+                check_parallel_node(as_ternary->falseb, ctx);
+                break;
+            }
+            case NodeType::If:
+            {
+                auto as_if = Node::as<IfNode>(node);
+                check_parallel_node(as_if->cond, ctx);
+                check_parallel_node(as_if->trueb, ctx);
+                check_parallel_node(as_if->falseb, ctx);
+                break;
+            }
+            case NodeType::Block:
+                ctx.locals.emplace_back();
+                for (const auto& st : Node::as<BlockNode>(node)->statements) {
+                    check_parallel_node(st, ctx);
+                }
+                ctx.locals.pop_back();
+                break;
+            case NodeType::FuncBody:
+                ctx.locals.emplace_back();
+                for (const auto& st : Node::as<FuncBodyNode>(node)->statements) {
+                    check_parallel_node(st, ctx);
+                }
+                ctx.locals.pop_back();
+                break;
+            case NodeType::VarDeclaration:
+            {
+                auto as_var_decl = Node::as<VarDeclarationNode>(node);
+                check_parallel_node(as_var_decl->initial, ctx);
+                declare(as_var_decl->name.value);
+                break;
+            }
+            case NodeType::ListDeclaration:
+            {
+                auto as_list_decl = Node::as<ListDeclarationNode>(node);
+                check_parallel_node(as_list_decl->initial, ctx);
+                declare(as_list_decl->name.value);
+                break;
+            }
+            case NodeType::Variable:
+            {
+                auto name = Node::as<VariableNode>(node)->token.value;
+                if (is_declared(ctx.locals, name) || ctx.list_params.find(name) != ctx.list_params.end()) {
+                    break;
+                }
+
+                if (ctx.in_function) {
+                    ctx.read_by_functions.insert(name);
+                } else if (name != ctx.iterator) {
+                    ctx.uses.push_back({name, {}, true, node});
+                }
+                break;
+            }
+            case NodeType::Index:
+                check_parallel_index(Node::as<IndexNode>(node), ctx, false);
+                break;
+            case NodeType::Assignment:
+            {
+                auto as_assignment = Node::as<AssignmentNode>(node);
+                auto target = as_assignment->expr;
+
+                if (target->kind() == NodeType::Variable) {
+                    auto name = Node::as<VariableNode>(target)->token.value;
+                    if (!is_declared(ctx.locals, name) && ctx.list_params.find(name) == ctx.list_params.end()) {
+                        not_parallel(node, ctx, PAR_ASSIGNS_OUTER_EXCP + name + "'.");
+                    }
+                } else if (target->kind() == NodeType::Index) {
+                    check_parallel_index(Node::as<IndexNode>(target), ctx, true);
+                } else {
+                    not_parallel(node, ctx, PAR_ORDER_EXCP);
+                }
+
+                check_parallel_node(as_assignment->val, ctx);
+                break;
+            }
+            case NodeType::ListExpression:
+                for (const auto& el : Node::as<ListExpressionNode>(node)->elements) {
+                    check_parallel_node(el, ctx);
+                }
+                break;
+            case NodeType::MapExpression:
+            {
+                auto as_map = Node::as<MapExpressionNode>(node);
+                for (size_t i = 0; i < as_map->keys.size(); i++) {
+                    check_parallel_node(as_map->keys[i], ctx);
+                    check_parallel_node(as_map->values[i], ctx);
+                }
+                break;
+            }
+            case NodeType::For:
+            {
+                auto as_for = Node::as<ForNode>(node);
+                ctx.locals.emplace_back();
+                check_parallel_node(as_for->ini, ctx);
+                check_parallel_node(as_for->cond, ctx);
+                check_parallel_node(as_for->incr, ctx);
+                check_loop_body(as_for->body);
+                ctx.locals.pop_back();
+                break;
+            }
+            case NodeType::ForEach:
+            {
+                auto as_foreach = Node::as<ForEachNode>(node);
+                check_parallel_node(as_foreach->lst, ctx);
+                ctx.locals.emplace_back();
+                declare(as_foreach->var.value);
+                if (as_foreach->value_var.tp != Lexing::NOTHING) {
+                    declare(as_foreach->value_var.value);
+                }
+                check_loop_body(as_foreach->body);
+                ctx.locals.pop_back();
+                break;
+            }
+            case NodeType::FoRange:
+            {
+                auto as_forange = Node::as<FoRangeNode>(node);
+                check_parallel_node(as_forange->first, ctx);
+                check_parallel_node(as_forange->second, ctx);
+                ctx.locals.emplace_back();
+                if (as_forange->var.tp != Lexing::NOTHING) {
+                    declare(as_forange->var.value);
+                }
+                check_loop_body(as_forange->body);
+                ctx.locals.pop_back();
+                break;
+            }
+            case NodeType::While:
+            {
+                auto as_while = Node::as<WhileNode>(node);
+                check_parallel_node(as_while->cond, ctx);
+                check_loop_body(as_while->body);
+                break;
+            }
+            case NodeType::Loop:
+                check_loop_body(Node::as<LoopNode>(node)->body);
+                break;
+            case NodeType::FuncCall:
+                check_parallel_call(Node::as<FuncCallNode>(node), ctx);
+                break;
+            case NodeType::MemberVar:
+                check_parallel_node(Node::as<MemberVarNode>(node)->inst, ctx);
+                break;
+            default:
+                // Declarations of functions, classes or modules, and creating instances.
+                not_parallel(node, ctx, PAR_ORDER_EXCP);
+        }
+    }
+
+    void SemanticAnalyzer::check_parallel_index(const std::shared_ptr<Parsing::IndexNode>& node, parallel_context& ctx, bool is_write) {
+        std::vector<std::shared_ptr<Node>> indices;
+        auto source = split_index(node, indices);
+
+        std::set<size_t> levels;
+        for (size_t i = 0; i < indices.size(); i++) {
+            auto& index = indices[i];
+            check_parallel_node(index, ctx);
+
+            if (!ctx.in_function && !ctx.iterator.empty() && index->kind() == NodeType::Variable &&
+                Node::as<VariableNode>(index)->token.value == ctx.iterator) {
+                levels.insert(i);
+            }
+        }
+
+        if (source->kind() != NodeType::Variable) {
+            if (is_write) {
+                not_parallel(node, ctx, PAR_ORDER_EXCP);
+            }
+            check_parallel_node(source, ctx);
+            return;
+        }
+
+        auto name = Node::as<VariableNode>(source)->token.value;
+        if (is_declared(ctx.locals, name)) {
+            return;
+        }
+
+        if (ctx.in_function) {
+            // Lists of the caller are written from a function only through its parameters,
+            // and those could be shared by all the iterations.
+            if (is_write) {
+                not_parallel(node, ctx, PAR_ASSIGNS_OUTER_EXCP + name + "'.");
+            }
+            if (ctx.list_params.find(name) == ctx.list_params.end()) {
+                ctx.read_by_functions.insert(name);
+            }
+            return;
+        }
+
+        auto found = currentScope->findSymbol(name);
+        if (is_write && found && found->tp && found->tp->kind == Interpreting::SymbolType::MapType) {
+            // Adding a key can move every entry, so no key of the map is independent of the others.
+            not_parallel(node, ctx, PAR_WRITES_MAP_EXCP + name + "'.");
+        }
+
+        if (is_write) {
+            if (levels.empty()) {
+                not_parallel(node, ctx, PAR_LIST_INDEX_EXCP + name + PAR_BY_ITERATOR_EXCP);
+            }
+            ctx.written.insert(name);
+        }
+
+        ctx.uses.push_back({name, levels, false, node});
+    }
+
+    void SemanticAnalyzer::check_parallel_call(const std::shared_ptr<Parsing::FuncCallNode>& node, parallel_context& ctx) {
+        // Native functions are found by name first, the same way the interpreter does.
+        if (node->fname.tp != Lexing::NOTHING && native_function_data.find(node->fname.value) != native_function_data.end()) {
+            static const std::set<std::string> pure_natives {
+                FACTR_FN, LENGTH_FN, FROM_ASCII_FN, TO_ASCII_FN, POW_FN, SQRT_FN, SIN_FN, COS_FN,
+                FLOOR_FN, TRUNC_FN, ROUND_FN, TYPEOF_FN, PUSH_FN, POP_FN,
+                SORT_FN, BINARY_SEARCH_FN, REVERSE_FN
+            };
+
+            auto& name = node->fname.value;
+            // A comparison function could do anything.
+            bool calls_back = (name == SORT_FN && node->args.size() > 1)
+                || (name == BINARY_SEARCH_FN && node->args.size() > 2);
+            if (calls_back || pure_natives.find(name) == pure_natives.end()) {
+                not_parallel(node, ctx, PAR_CALLS_EXCP + name + PAR_SIDE_EFFECTS_EXCP);
+            }
+
+            size_t first_arg = 0;
+            if ((name == PUSH_FN || name == POP_FN || name == SORT_FN || name == REVERSE_FN) && !node->args.empty()) {
+                // These change the list they get, so it has to belong to the iteration.
+                auto& lst = node->args[0];
+                if (lst->kind() != NodeType::Variable || !is_declared(ctx.locals, Node::as<VariableNode>(lst)->token.value)) {
+                    not_parallel(node, ctx, PAR_CALLS_EXCP + name + PAR_ON_OUTER_LIST_EXCP);
+                }
+                first_arg = 1;
+            } else if (name == LENGTH_FN && node->args.size() == 1 && node->args[0]->kind() == NodeType::Variable) {
+                // Only the size is read, and no list can change its size inside of the loop.
+                first_arg = 1;
+            }
+
+            for (size_t i = first_arg; i < node->args.size(); i++) {
+                check_parallel_node(node->args[i], ctx);
+            }
+            return;
+        }
+
+        for (const auto& arg : node->args) {
+            check_parallel_node(arg, ctx);
+        }
+
+        auto& fn = node->expr;
+        if (fn->kind() == NodeType::Variable) {
+            auto name = Node::as<VariableNode>(fn)->token.value;
+            auto found = is_declared(ctx.locals, name) ? nullptr : currentScope->findSymbol(name);
+            auto declaration = found ? function_declarations.find(found) : function_declarations.end();
+
+            if (declaration == function_declarations.end()) {
+                not_parallel(node, ctx, PAR_CALLS_EXCP + name + PAR_SIDE_EFFECTS_EXCP);
+            }
+
+            check_parallel_function(declaration->second, ctx);
+        } else if (fn->kind() == NodeType::StaticVar) {
+            auto as_static = Node::as<StaticVarNode>(fn);
+            auto module_symbol = as_static->inst->kind() == NodeType::Variable
+                ? currentScope->findSymbol(Node::as<VariableNode>(as_static->inst)->token.value)
+                : nullptr;
+            auto as_native_module = module_symbol
+                ? std::dynamic_pointer_cast<Modules::NativeModule>(module_symbol->value)
+                : nullptr;
+
+            if (!as_native_module || !as_native_module->is_pure()) {
+                not_parallel(node, ctx, PAR_CALLS_EXCP + as_static->name.value + PAR_SIDE_EFFECTS_EXCP);
+            }
+        } else {
+            not_parallel(node, ctx, PAR_ORDER_EXCP);
+        }
+    }
+
+    void SemanticAnalyzer::check_parallel_function(const std::shared_ptr<Parsing::FuncDeclNode>& node, parallel_context& ctx) {
+        // Also stops recursive functions from being checked forever.
+        if (!ctx.checked_functions.insert(node.get()).second) {
+            return;
+        }
+
+        auto locals = std::move(ctx.locals);
+        auto list_params = std::move(ctx.list_params);
+        auto in_function = ctx.in_function;
+        auto loop_depth = ctx.loop_depth;
+
+        ctx.locals = {{}};
+        ctx.list_params = {};
+        ctx.in_function = true;
+        ctx.loop_depth = 0;
+
+        for (const auto& par : node->params) {
+            // Lists are passed by reference, everything else is copied into the call.
+            if (par->kind() == NodeType::ListDeclaration) {
+                ctx.list_params.insert(Node::as<ListDeclarationNode>(par)->name.value);
+            } else if (par->kind() == NodeType::VarDeclaration) {
+                ctx.locals.back().insert(Node::as<VarDeclarationNode>(par)->name.value);
+            }
+        }
+
+        check_parallel_node(node->body, ctx);
+
+        ctx.locals = std::move(locals);
+        ctx.list_params = std::move(list_params);
+        ctx.in_function = in_function;
+        ctx.loop_depth = loop_depth;
+    }
+
+    Interpreting::Symbol* SemanticAnalyzer::check_task_function(const std::shared_ptr<Parsing::FuncCallNode>& call, const std::shared_ptr<Parsing::Node>& node, size_t n_arguments) {
+        auto function_type = visit(node).type;
+
+        std::shared_ptr<FuncDeclNode> declaration;
+        if (node->kind() == NodeType::Variable) {
+            auto found = currentScope->findSymbol(Node::as<VariableNode>(node)->token.value);
+            auto declared = function_declarations.find(found);
+            if (declared != function_declarations.end()) {
+                declaration = declared->second;
+            }
+        }
+
+        if (!declaration || !function_type || function_type->kind != Interpreting::SymbolType::FunctionType) {
+            throw Exceptions::TypeException(
+                TASK_NEEDS_FUNC_EXCP,
+                call->line_number,
+                call->column_number
+            );
+        }
+
+        auto params = get_function_semantic_context(function_type);
+        bool callable = params.size() >= n_arguments;
+        for (size_t i = n_arguments; i < params.size(); i++) {
+            // Every parameter that won't get a value has to be optional.
+            callable = callable && params[i].second;
+        }
+
+        if (!callable) {
+            throw Exceptions::SemanticException(
+                TASK_FUNC_ARGS_EXCP + std::to_string(n_arguments),
+                call->line_number,
+                call->column_number
+            );
+        }
+
+        parallel_context ctx;
+        ctx.subject = "'" + declaration->name.value + TASK_NOT_INDEPENDENT_EXCP;
+        check_parallel_function(declaration, ctx);
+
+        // The caller keeps running while the task does, so it could change anything the task reads.
+        if (!ctx.read_by_functions.empty()) {
+            not_parallel(call, ctx, TASK_READS_OUTER_EXCP + *ctx.read_by_functions.begin() + "'.");
+        }
+
+        return function_type;
+    }
+
+    NodeResult SemanticAnalyzer::check_task_spawn(const std::shared_ptr<Parsing::FuncCallNode>& node) {
+        if (node->args.size() != 1) {
+            throw Exceptions::SemanticException(
+                FUNC_OF_TP_EXCP + visit(node->expr).type->name + TAKES_EXCP + "1" + ARGS_BUT_CALLED_EXCP + std::to_string(node->args.size()),
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        // The handle is called like the function to get its result, so it has the same type.
+        return {check_task_function(node, node->args[0], 0), false, true};
+    }
+
+    NodeResult SemanticAnalyzer::check_task_await(const std::shared_ptr<Parsing::FuncCallNode>& node) {
+        if (node->args.size() != 1) {
+            throw Exceptions::SemanticException(
+                FUNC_OF_TP_EXCP + visit(node->expr).type->name + TAKES_EXCP + "1" + ARGS_BUT_CALLED_EXCP + std::to_string(node->args.size()),
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        auto handle_type = visit(node->args[0]).type;
+        bool takes_arguments = false;
+        if (handle_type && handle_type->kind == Interpreting::SymbolType::FunctionType) {
+            for (const auto& param : get_function_semantic_context(handle_type)) {
+                takes_arguments = takes_arguments || !param.second;
+            }
+        }
+
+        if (!handle_type || handle_type->kind != Interpreting::SymbolType::FunctionType || takes_arguments) {
+            throw Exceptions::TypeException(
+                TASK_AWAIT_EXCP,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        return {handle_type->tp, false, true};
+    }
+
+    NodeResult SemanticAnalyzer::check_task_map(const std::shared_ptr<Parsing::FuncCallNode>& node) {
+        if (node->args.size() != 2) {
+            throw Exceptions::SemanticException(
+                FUNC_OF_TP_EXCP + visit(node->expr).type->name + TAKES_EXCP + "2" + ARGS_BUT_CALLED_EXCP + std::to_string(node->args.size()),
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        auto list_type = visit(node->args[0]).type;
+        if (!list_type || list_type->kind != Interpreting::SymbolType::ListType) {
+            throw Exceptions::TypeException(
+                TASK_MAP_LIST_EXCP,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        auto function_type = check_task_function(node, node->args[1], 1);
+        auto param_type = get_function_semantic_context(function_type)[0].first;
+        if (!counts_as(list_type->tp, param_type)) {
+            throw Exceptions::TypeException(
+                INVALID_TP_FOR_ARG_EXCP + std::string("0") + EXPC_TP_EXCP + param_type->name + BUT_RECVD_EXCP + list_type->tp->name,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        if (!function_type->tp) {
+            throw Exceptions::TypeException(
+                TASK_MAP_VOID_EXCP,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        return {handle_list_type(function_type->tp), false, true};
+    }
+
+    NodeResult SemanticAnalyzer::check_vec_arg(const std::shared_ptr<Parsing::FuncCallNode>& node, size_t index, bool is_list) {
+        auto arg = visit(node->args[index]);
+        auto tp = arg.type;
+        if (is_list) {
+            if (!tp || tp->kind != Interpreting::SymbolType::ListType || (tp->tp != type_int && tp->tp != type_double)) {
+                throw Exceptions::TypeException(
+                    VEC_LIST_ARG_EXCP + std::to_string(index) + ".",
+                    node->line_number,
+                    node->column_number
+                );
+            }
+            // The type of the elements is what decides the type of the result.
+            arg.type = tp->tp;
+        } else if (tp != type_int && tp != type_double) {
+            throw Exceptions::TypeException(
+                VEC_NUMBER_ARG_EXCP + std::to_string(index) + ".",
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        return arg;
+    }
+
+    NodeResult SemanticAnalyzer::check_vec_call(const std::shared_ptr<Parsing::FuncCallNode>& node, size_t n_lists, size_t n_numbers, vec_result result) {
+        auto n_args = n_lists + n_numbers;
+        if (node->args.size() != n_args) {
+            throw Exceptions::SemanticException(
+                FUNC_OF_TP_EXCP + visit(node->expr).type->name + TAKES_EXCP + std::to_string(n_args) + ARGS_BUT_CALLED_EXCP + std::to_string(node->args.size()),
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        bool all_int = true;
+        bool is_constant = true;
+        bool has_side_effects = false;
+        for (size_t i = 0; i < n_args; i++) {
+            auto arg = check_vec_arg(node, i, i < n_lists);
+            is_constant = is_constant && arg.is_constant;
+            has_side_effects = has_side_effects || arg.has_side_effects;
+            all_int = all_int && arg.type == type_int;
+        }
+
+        auto number_type = all_int ? type_int : type_double;
+        switch (result) {
+            case vec_result::Number:
+                return {number_type, is_constant, has_side_effects};
+            case vec_result::Index:
+                return {type_int, is_constant, has_side_effects};
+            case vec_result::List:
+                return {handle_list_type(number_type), is_constant, has_side_effects};
+        }
+
+        return {};
+    }
+
+    NodeResult SemanticAnalyzer::check_vec_map(const std::shared_ptr<Parsing::FuncCallNode>& node) {
+        if (node->args.size() != 2) {
+            throw Exceptions::SemanticException(
+                FUNC_OF_TP_EXCP + visit(node->expr).type->name + TAKES_EXCP + "2" + ARGS_BUT_CALLED_EXCP + std::to_string(node->args.size()),
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        auto list = check_vec_arg(node, 0, true);
+
+        // Only functions of native modules are taken, so the call stays independent of the program.
+        auto& fn = node->args[1];
+        std::shared_ptr<Modules::NativeModule> module;
+        if (fn->kind() == NodeType::StaticVar) {
+            auto as_static = Node::as<StaticVarNode>(fn);
+            auto module_symbol = as_static->inst->kind() == NodeType::Variable
+                ? currentScope->findSymbol(Node::as<VariableNode>(as_static->inst)->token.value)
+                : nullptr;
+            module = module_symbol
+                ? std::dynamic_pointer_cast<Modules::NativeModule>(module_symbol->value)
+                : nullptr;
+        }
+
+        auto function_type = visit(fn).type;
+        bool valid = module && function_type && function_type->kind == Interpreting::SymbolType::FunctionType
+            && (function_type->tp == type_int || function_type->tp == type_double);
+
+        if (valid) {
+            auto params = get_function_semantic_context(function_type);
+            valid = !params.empty() && params[0].first == type_double;
+            for (size_t i = 1; i < params.size(); i++) {
+                valid = valid && params[i].second;
+            }
+        }
+
+        if (!valid) {
+            throw Exceptions::TypeException(
+                VEC_MAP_FUNC_EXCP,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        return {handle_list_type(function_type->tp), list.is_constant, list.has_side_effects};
+    }
+
     NodeResult SemanticAnalyzer::visit_While(const std::shared_ptr<Parsing::WhileNode>& node) {
         auto whileScope = Interpreting::SymbolTable("while:loop", {}, currentScope);
         currentScope = &whileScope;
@@ -1038,6 +1834,9 @@ namespace Odo::Semantics {
                 );
             }
             return {visited_val.type->tp, visited_val.is_constant};
+        } else if (visited_val.type->kind == Interpreting::SymbolType::MapType) {
+            check_map_key(visited_val.type, visit(node->expr), node);
+            return {visited_val.type->tp, visited_val.is_constant};
         } else {
             throw Exceptions::ValueException(
                     INDX_ONLY_LST_STR_EXCP,
@@ -1091,7 +1890,10 @@ namespace Odo::Semantics {
         // If a variable is constant, should it be replaced by the calculation of it's result?
 
         if (node->initial && node->initial->kind() != NodeType::NoOp) {
+            auto prev_accepted_map = accepted_map_type;
+            accepted_map_type = type_->kind == Interpreting::SymbolType::MapType ? type_ : nullptr;
             auto newValue = visit(node->initial);
+            accepted_map_type = prev_accepted_map;
 
             if (!newValue.type) {
                 throw Exceptions::ValueException(
@@ -1244,7 +2046,10 @@ namespace Odo::Semantics {
             if (is_list_type) {
                 accepted_list_type = varSym->tp->tp;
             }
+            auto prev_acc_map = accepted_map_type;
+            accepted_map_type = varSym->tp->kind == Interpreting::SymbolType::MapType ? varSym->tp : nullptr;
             auto newValue = visit(node->val);
+            accepted_map_type = prev_acc_map;
             if (is_list_type) {
                 accepted_list_type = prev_acc_list;
             }
@@ -1300,7 +2105,7 @@ namespace Odo::Semantics {
                 result.type = handle_list_type(el_result.type);
             }
             else if (result.type->tp != el_result.type && !is_any) {
-                result.type = inter.globalTable.addListType(inter.any_type());
+                result.type = inter.globalTable->addListType(inter.any_type());
                 is_any = true;
             }
 
@@ -1314,6 +2119,82 @@ namespace Odo::Semantics {
         return result;
     }
 
+    NodeResult SemanticAnalyzer::visit_MapExpression(const std::shared_ptr<Parsing::MapExpressionNode>& node) {
+        if (node->keys.empty()) {
+            auto map_type = accepted_map_type
+                ? accepted_map_type
+                : handle_map_type(inter.any_type(), inter.any_type(), node);
+            return {map_type, true, false};
+        }
+
+        NodeResult result{};
+        Interpreting::Symbol* key_type = nullptr;
+        Interpreting::Symbol* value_type = nullptr;
+
+        for (size_t i = 0; i < node->keys.size(); i++) {
+            auto key_result = visit(node->keys[i]);
+            auto value_result = visit(node->values[i]);
+            if (!key_result.type || !value_result.type) {
+                throw Exceptions::TypeException(
+                    MAP_EL_NO_VALUE_EXCP,
+                    node->line_number,
+                    node->column_number
+                );
+            }
+
+            if (!key_type) {
+                key_type = key_result.type;
+                value_type = value_result.type;
+            } else {
+                if (key_type != key_result.type) {
+                    throw Exceptions::TypeException(
+                        MAP_KEYS_SAME_TYPE_EXCP,
+                        node->line_number,
+                        node->column_number
+                    );
+                }
+
+                if (value_type != value_result.type) {
+                    value_type = inter.any_type();
+                }
+            }
+
+            result.is_constant = result.is_constant && key_result.is_constant && value_result.is_constant;
+            result.has_side_effects = result.has_side_effects || key_result.has_side_effects || value_result.has_side_effects;
+        }
+
+        result.type = handle_map_type(key_type, value_type, node);
+        return result;
+    }
+
+    void SemanticAnalyzer::check_map_key(Interpreting::Symbol* map_type, const NodeResult& key, const std::shared_ptr<Parsing::Node>& node) {
+        if (!key.type) {
+            throw Exceptions::ValueException(
+                INDEX_MUST_BE_VALID_EXCP,
+                node->line_number,
+                node->column_number
+            );
+        }
+
+        // Keys are compared by their type too, so 1 and 1.0 are different keys.
+        auto key_tp = map_type->key_tp;
+        if (key_tp == inter.any_type()) {
+            if (!is_map_key_type(key.type)) {
+                throw Exceptions::TypeException(
+                    MAP_KEY_TYPE_EXCP + key.type->name + ".",
+                    node->line_number,
+                    node->column_number
+                );
+            }
+        } else if (key.type != key_tp) {
+            throw Exceptions::TypeException(
+                MAP_INDX_KEY_EXCP + key_tp->name + ".",
+                node->line_number,
+                node->column_number
+            );
+        }
+    }
+
     SemanticAnalyzer::arg_types SemanticAnalyzer::getParamTypes(const std::vector<std::shared_ptr<Node>>& params) {
         arg_types ts;
 
@@ -1490,6 +2371,12 @@ namespace Odo::Semantics {
         });
         func_symbol->is_initialized = true;
 
+        function_declarations[func_symbol] = node;
+        func_symbol->ondestruction = [this](auto* sym){
+            if (deactivate_cleanup) return;
+            function_declarations.erase(sym);
+        };
+
         auto temp = currentScope;
         currentScope = &func_scope;
         for (const auto& par : node->params) {
@@ -1569,6 +2456,14 @@ namespace Odo::Semantics {
         }
         auto functionType = fVal.type;
 
+        if (!call_checks.empty() && (node->expr->kind() == NodeType::StaticVar || node->expr->kind() == NodeType::Variable)) {
+            auto callee = getSymbolFromNode(node->expr);
+            auto checked = callee ? call_checks.find(callee->value.get()) : call_checks.end();
+            if (checked != call_checks.end()) {
+                return checked->second(node);
+            }
+        }
+
         if (fVal.type->kind == Interpreting::SymbolType::FunctionType) {
             const auto& parameters_in_template = get_function_semantic_context(functionType);
             auto& call_args = node->args;
@@ -2172,11 +3067,7 @@ namespace Odo::Semantics {
     }
 
     void SemanticAnalyzer::analyze_as_module(const std::string& path, const Lexing::Token& name) {
-        bool has_extension = ends_with(path, ".odo");
-
-        std::string full_path = path;
-        if (!has_extension)
-            full_path += ".odo";
+        auto full_path = Parsing::ModuleLoader::full_path(path);
         auto filename = io::get_file_name(full_path, true);
 
         if (name.tp != Lexing::NOTHING)
@@ -2188,17 +3079,13 @@ namespace Odo::Semantics {
             );
         }
 
-        std::string code;
+        std::vector<std::shared_ptr<Node>> body;
         try {
-            code = io::read_file(full_path);
+            body = inter.modules.get(full_path);
         } catch (Exceptions::IOException&) {
             std::string msg = CANNOT_IMPORT_MODULE_EXCP + full_path + "'.";
             throw Exceptions::FileException(msg);
         }
-        Parsing::Parser pr;
-        pr.set_text(code);
-
-        auto body = pr.program_content();
 
         auto file_module = ModuleNode::create(
             Lexing::Token(Lexing::STR, filename),
@@ -2210,12 +3097,70 @@ namespace Odo::Semantics {
     }
 
     NodeResult SemanticAnalyzer::from_repl(const std::shared_ptr<Parsing::Node> & node) {
+        // Only the new statement is analyzed. Everything declared before it stays in
+        // replScope, and function bodies are still checked lazily on their first call.
+        // If the statement fails, the analyzer state is restored so the next line
+        // starts from the same place instead of a half-visited context.
         auto temp_scope = currentScope;
+        auto lazy_depth = lazy_scope_stack.size();
+        auto temp_inside_loop = inside_loop;
+        auto temp_can_return = can_return;
+        auto temp_return_type = accepted_return_type;
+        auto temp_list_type = accepted_list_type;
+
         currentScope = &replScope;
 
-        auto result = visit(node);
+        NodeResult result;
+        try {
+            result = visit(node);
+        } catch (Exceptions::OdoException&) {
+            while (lazy_scope_stack.size() > lazy_depth) {
+                lazy_scope_stack.pop_back();
+            }
+            current_lazy_scope = lazy_scope_stack.empty() ? nullptr : &lazy_scope_stack.back();
+
+            inside_loop = temp_inside_loop;
+            can_return = temp_can_return;
+            accepted_return_type = temp_return_type;
+            accepted_list_type = temp_list_type;
+            currentScope = temp_scope;
+            throw;
+        }
 
         currentScope = temp_scope;
         return result;
     }
+
+    std::string SemanticAnalyzer::forget_repl_declaration(const std::shared_ptr<Parsing::Node>& node) {
+        std::string name;
+        switch (node->kind()) {
+            case NodeType::VarDeclaration:
+                name = Node::as<VarDeclarationNode>(node)->name.value;
+                break;
+            case NodeType::ListDeclaration:
+                name = Node::as<ListDeclarationNode>(node)->name.value;
+                break;
+            case NodeType::FuncDecl:
+                name = Node::as<FuncDeclNode>(node)->name.value;
+                break;
+            case NodeType::Class:
+                name = Node::as<ClassNode>(node)->name.value;
+                break;
+            case NodeType::Enum:
+                name = Node::as<EnumNode>(node)->name.value;
+                break;
+            case NodeType::Module:
+                name = Node::as<ModuleNode>(node)->name.value;
+                break;
+            default:
+                return "";
+        }
+
+        auto found = replScope.findSymbol(name, false);
+        if (found) {
+            drop_lazy(found);
+            replScope.removeSymbol(found);
+        }
+        return name;
+    }
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
 
 #include "Modules/IOModule.h"
 #include "Modules/MathModule.h"
+#include "Modules/TaskModule.h"
+#include "Modules/VecModule.h"
+#include "Modules/MatrixModule.h"
 
 #include "external/rang.hpp"
 #include "external/flags.h"
@@ -69,7 +72,7 @@ void repl(Odo::Interpreting::Interpreter& inter) {
         std::cout << "> " << std::flush;
         std::string code;
         std::cout << rang::fg::yellow;
-        std::getline(std::cin, code);
+        Odo::io::standard_input().read_line(code);
         std::cout << rang::style::reset;
 
         // Handle potential errors
@@ -101,6 +104,7 @@ void repl(Odo::Interpreting::Interpreter& inter) {
 }
 
 int entry(int argc, char* argv[]) {
+    Odo::io::buffer_stdout();
     auto args = flags::args(argc, argv);
 
 //    std::string logo = LOGO;
@@ -123,6 +127,14 @@ int entry(int argc, char* argv[]) {
     }
     auto use_repl = args.get<bool>("i", false);
 
+    if (args.get<std::string_view>("heap-profile")) {
+        std::cerr << rang::fg::red << "Error! The flag 'heap-profile' does not take any arguments.\n" << rang::fg::reset;
+        return 1;
+    }
+    if (args.get<bool>("heap-profile", false)) {
+        Interpreting::HeapProfile::enable();
+    }
+
     const auto& pos_args = args.positional();
 
     std::string input_file;
@@ -133,9 +145,21 @@ int entry(int argc, char* argv[]) {
 
     Interpreting::Interpreter inter;
 
+    // What's still alive once the program is done, written before the interpreter lets go of it.
+    // Tasks started from the repl can still be running, and changing the values.
+    auto report_heap = [&inter] {
+        if (!Interpreting::HeapProfile::enabled()) return;
+        inter.get_task_pool().wait_all();
+        std::cout << std::flush;
+        Interpreting::HeapProfile::report(std::cerr);
+    };
+
     // Investigate what happens when adding two modules with the same name
     add_module<Modules::IOModule>(inter);
     add_module<Modules::MathModule>(inter);
+    add_module<Modules::TaskModule>(inter);
+    add_module<Modules::VecModule>(inter);
+    add_module<Modules::MatrixModule>(inter);
 
     // Opening file and reading contents:
     std::string code;
@@ -170,6 +194,7 @@ int entry(int argc, char* argv[]) {
             calls.clear();
 
             std::cerr << e.msg() << rang::style::reset << std::flush;
+            report_heap();
             return 1;
         }
     }
@@ -177,6 +202,8 @@ int entry(int argc, char* argv[]) {
     if (use_repl || code.empty()) {
         repl(inter);
     }
+
+    report_heap();
     return 0;
 }
 
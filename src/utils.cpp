@@ -4,12 +4,10 @@
 
 #include "utils.h"
 #include <chrono>
+#include <thread>
 
 namespace Odo {
-    bool has_init_generator = false;
     typedef std::chrono::high_resolution_clock myclock;
-    std::default_random_engine generator;
-
     bool contains_type(std::vector<Lexing::TokenType> arr, Lexing::TokenType t) {
         return std::find(arr.begin(), arr.end(), t) != arr.end();
     }
@@ -30,28 +28,25 @@ namespace Odo {
         }
     }
 
+    // Each thread seeds its own engine the first time it asks for a number.
+    static std::default_random_engine& generator() {
+        thread_local std::default_random_engine engine = [] {
+            auto in_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(myclock::now().time_since_epoch()).count();
+            auto thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+            return std::default_random_engine((unsigned int)(in_nanos ^ thread_hash));
+        }();
+
+        return engine;
+    }
+
     int rand_int(int min, int max) {
-        if (!has_init_generator) {
-            myclock::time_point beginning = myclock::now();
-            auto time_since = beginning.time_since_epoch();
-            auto in_millis = std::chrono::duration_cast<std::chrono::nanoseconds>(time_since).count();
-            generator = std::default_random_engine((unsigned int)in_millis);
-            has_init_generator = true;
-        }
         std::uniform_int_distribution<int> distribution(min, max-1);
-        return distribution(generator);
+        return distribution(generator());
     }
 
     double rand_double(double min, double max) {
-        if (!has_init_generator) {
-            myclock::time_point beginning = myclock::now();
-            auto time_since = beginning.time_since_epoch();
-            auto in_millis = std::chrono::duration_cast<std::chrono::nanoseconds>(time_since).count();
-            generator = std::default_random_engine((unsigned int)in_millis);
-            has_init_generator = true;
-        }
         std::uniform_real_distribution<double> distribution(min, max);
-        return distribution(generator);
+        return distribution(generator());
     }
 
     double rand_double(double max) { return rand_double(0, max); }
@@ -131,8 +131,16 @@ class FileTestResult(TestResult):
 
 
 def test_file(path):
+    # A test reads its standard input from the file next to it with the same name and a .in extension, if there is one.
+    input_path = path[:-5] + '.in'
+    test_input = None
+    if os.path.isfile(input_path):
+        with open(input_path) as f:
+            test_input = f.read()
+
     try:
-        program = subprocess.run(["odo", path], capture_output=True, text=True, check=True)
+        program = subprocess.run(["odo", path], input=test_input, stdin=None if test_input is not None else subprocess.DEVNULL,
+                                 capture_output=True, text=True, check=True)
         if program.stdout == "bad": return (1, "bad")
         if program.stdout == "good": return (0, "good")
 